@@ -13,11 +13,12 @@
 #include "brave/components/brave_ads/content/browser/search_result_ad/search_result_ad_service.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
-#include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
 #include "components/sessions/content/session_tab_helper.h"
+#include "content/public/browser/global_routing_id.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "ui/base/page_transition_types.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
@@ -70,34 +71,72 @@ void AdsTabHelper::TabUpdated() {
                                is_browser_active_);
 }
 
-void AdsTabHelper::RunIsolatedJavaScript(
+void AdsTabHelper::ProcessPageContent(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
+  if (!ads_service_) {
+    return;
+  }
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
-                     weak_factory_.GetWeakPtr()));
+  // Rebind for each document so that a previous document is not reported for
+  // the current one.
+  page_features_extractor_.reset();
+  render_frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      &page_features_extractor_);
+
+  ads_service_->IsFullHtmlContentNeeded(
+      redirect_chain_,
+      base::BindOnce(&AdsTabHelper::OnIsFullHtmlContentNeeded,
+                     weak_factory_.GetWeakPtr(),
+                     render_frame_host->GetGlobalId()));
+
+  // The renderer caps the text, so pages with a lot of text are not copied
+  // in full to the browser and the ads service.
+  page_features_extractor_->ExtractText(
+      base::BindOnce(&AdsTabHelper::OnExtractText, weak_factory_.GetWeakPtr()));
 }
 
-void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
+void AdsTabHelper::OnIsFullHtmlContentNeeded(
+    const content::GlobalRenderFrameHostId& render_frame_host_id,
+    const bool is_needed) {
+  content::RenderFrameHost* render_frame_host =
+      content::RenderFrameHost::FromID(render_frame_host_id);
+  if (!render_frame_host) {
+    return;
+  }
+
+  if (is_needed) {
+    dom_distiller::RunIsolatedJavaScript(
+        render_frame_host, "new XMLSerializer().serializeToString(document)",
+        base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
+                       weak_factory_.GetWeakPtr()));
+    return;
+  }
+
+  // Serializing the document is costly for large pages, so only send the
+  // <meta> elements when they are all the ads service reads from the HTML.
+  page_features_extractor_->ExtractMetaHtml(base::BindOnce(
+      &AdsTabHelper::OnExtractMetaHtml, weak_factory_.GetWeakPtr()));
+}
+
+void AdsTabHelper::OnExtractMetaHtml(const std::string& meta_html) {
   if (!ads_service_) {
     return;
   }
 
-  if (!value.is_string()) {
+  ads_service_->OnTabHtmlContentDidChange(tab_id_, redirect_chain_, meta_html);
+}
+
+void AdsTabHelper::OnExtractText(const std::string& text) {
+  if (!ads_service_) {
     return;
   }
-  const std::string& html = value.GetString();
-  ads_service_->OnTabHtmlContentDidChange(tab_id_, redirect_chain_, html);
+
+  ads_service_->OnTabTextContentDidChange(tab_id_, redirect_chain_, text);
 }
 
-void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
+void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
   if (!ads_service_) {
     return;
   }
@@ -105,8 +144,8 @@ void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
   if (!value.is_string()) {
     return;
   }
-  const std::string& text = value.GetString();
-  ads_service_->OnTabTextContentDidChange(tab_id_, redirect_chain_, text);
+  const std::string& html = value.GetString();
+  ads_service_->OnTabHtmlContentDidChange(tab_id_, redirect_chain_, html);
 }
 
 void AdsTabHelper::DidFinishNavigation(
@@ -139,7 +178,7 @@ void AdsTabHelper::DidFinishNavigation(
   content::RenderFrameHost* render_frame_host =
       navigation_handle->GetRenderFrameHost();
 
-  RunIsolatedJavaScript(render_frame_host);
+  ProcessPageContent(render_frame_host);
 }
 
 void AdsTabHelper::DocumentOnLoadCompletedInPrimaryMainFrame() {
@@ -154,7 +193,7 @@ void AdsTabHelper::DocumentOnLoadCompletedInPrimaryMainFrame() {
     return;
   }
 
-  RunIsolatedJavaScript(render_frame_host);
+  ProcessPageContent(render_frame_host);
 }
 
 void AdsTabHelper::DidFinishLoad(content::RenderFrameHost* render_frame_host,
@@ -6,15 +6,18 @@
 #ifndef BRAVE_BROWSER_BRAVE_ADS_ADS_TAB_HELPER_H_
 #define BRAVE_BROWSER_BRAVE_ADS_ADS_TAB_HELPER_H_
 
+#include <string>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "brave/components/brave_ads/common/page_features_extractor.mojom.h"
 #include "build/build_config.h"
 #include "components/sessions/core/session_id.h"
 #include "content/public/browser/media_player_id.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
 
 #if !BUILDFLAG(IS_ANDROID)
 #include "chrome/browser/ui/browser_list_observer.h"
@@ -23,15 +26,9 @@
 class Browser;
 class GURL;
 
-namespace dom_distiller {
-
-class DistillerPage;
-
-namespace proto {
-class DomDistillerResult;
-}  // namespace proto
-
-}  // namespace dom_distiller
+namespace content {
+struct GlobalRenderFrameHostId;
+}  // namespace content
 
 namespace brave_ads {
 
@@ -55,11 +52,17 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void TabUpdated();
 
-  void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
+  void ProcessPageContent(content::RenderFrameHost* render_frame_host);
 
-  void OnJavaScriptHtmlResult(base::Value value);
+  void OnIsFullHtmlContentNeeded(
+      const content::GlobalRenderFrameHostId& render_frame_host_id,
+      bool is_needed);
 
-  void OnJavaScriptTextResult(base::Value value);
+  void OnExtractMetaHtml(const std::string& meta_html);
+
+  void OnExtractText(const std::string& text);
+
+  void OnJavaScriptHtmlResult(base::Value value);
 
   // content::WebContentsObserver overrides
   void DidFinishNavigation(
@@ -91,6 +94,8 @@ class AdsTabHelper : public content::WebContentsObserver,
   std::vector<GURL> redirect_chain_;
   bool should_process_ = false;
 
+  mojo::AssociatedRemote<mojom::PageFeaturesExtractor> page_features_extractor_;
+
   base::WeakPtrFactory<AdsTabHelper> weak_factory_;
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
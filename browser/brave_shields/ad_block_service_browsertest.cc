@@ -470,6 +470,37 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByRegionalBlocker) {
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
+// Block an ad with the regional blocker, then disable its list and make sure
+// the decision cached for the ad is no longer served.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       AdsNoLongerBlockedAfterRegionalListDisabled) {
+  g_browser_process->SetApplicationLocale("fr");
+  ASSERT_STREQ(g_browser_process->GetApplicationLocale().c_str(), "fr");
+
+  ASSERT_TRUE(InstallRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
+
+  GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), url));
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 1, 0, 0);"
+                         "addImage('ad_fr.png')"));
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+
+  g_brave_browser_process->ad_block_service()
+      ->regional_service_manager()
+      ->EnableFilterList(kAdBlockEasyListFranceUUID, false);
+  WaitForAdBlockServiceThreads();
+
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), url));
+  contents = browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(1, 0, 0, 0);"
+                         "addImage('ad_fr.png')"));
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+}
+
 // Load a page with an image which is not an ad, and make sure it is
 // NOT blocked by the regional blocker.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
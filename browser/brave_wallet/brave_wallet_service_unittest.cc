@@ -9,6 +9,7 @@
 
 #include "base/json/json_reader.h"
 #include "base/memory/raw_ptr.h"
+#include "base/strings/string_util.h"
 #include "base/test/bind.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
@@ -660,7 +661,7 @@ class BraveWalletServiceUnitTest : public testing::Test {
                                     mojom::CoinType::ETH);
     } else {
       service_->NotifyAddSuggestTokenRequestsProcessed(
-          approve, {suggested_token->contract_address});
+          approve, {requests[0]->token->contract_address});
     }
     run_loop.Run();
 
@@ -1976,6 +1977,24 @@ TEST_F(BraveWalletServiceUnitTest, AddSuggestToken) {
                                chain_id, mojom::CoinType::ETH);
     EXPECT_EQ(token, usdc_from_blockchain_registry);
 
+    // Case 4b: Same as case 4, but the suggested address is lowercase. The
+    // request should still be resolved with the address of the token from
+    // BlockchainRegistry.
+    ASSERT_TRUE(
+        service_->RemoveUserAsset(usdc_from_blockchain_registry.Clone()));
+    mojom::BlockchainTokenPtr usdc_lowercase_from_request =
+        usdc_from_request.Clone();
+    usdc_lowercase_from_request->contract_address =
+        base::ToLowerASCII(usdc_from_request->contract_address);
+    AddSuggestToken(usdc_lowercase_from_request.Clone(),
+                    usdc_from_blockchain_registry.Clone(), true);
+    token =
+        service_->GetUserAsset(usdc_from_blockchain_registry->contract_address,
+                               usdc_from_blockchain_registry->token_id,
+                               usdc_from_blockchain_registry->is_erc721,
+                               chain_id, mojom::CoinType::ETH);
+    EXPECT_EQ(token, usdc_from_blockchain_registry);
+
     mojom::BlockchainTokenPtr usdt_from_user_assets =
         mojom::BlockchainToken::New(
             "0xdAC17F958D2ee523a2206206994597C13D831ec7", "Tether", "usdt.png",
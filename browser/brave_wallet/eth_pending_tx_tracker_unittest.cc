@@ -93,6 +93,30 @@ TEST_F(EthPendingTxTrackerUnitTest, IsNonceTaken) {
   tx_state_manager.AddOrUpdateTx(meta_in_state);
 
   EXPECT_TRUE(pending_tx_tracker.IsNonceTaken(meta));
+
+  // A tx does not take its own nonce.
+  EXPECT_FALSE(pending_tx_tracker.IsNonceTaken(meta_in_state));
+
+  // Nonces are per sender.
+  EthTxMeta meta_other_from;
+  meta_other_from.set_from(
+      EthAddress::FromHex("0x3535353535353535353535353535353535353535")
+          .ToChecksumAddress());
+  meta_other_from.set_id(TxMeta::GenerateMetaID());
+  meta_other_from.tx()->set_nonce(uint256_t(123));
+  EXPECT_FALSE(pending_tx_tracker.IsNonceTaken(meta_other_from));
+
+  // Only confirmed txs take a nonce.
+  meta_in_state.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager.AddOrUpdateTx(meta_in_state);
+  EXPECT_FALSE(pending_tx_tracker.IsNonceTaken(meta));
+
+  meta_in_state.set_status(mojom::TransactionStatus::Confirmed);
+  tx_state_manager.AddOrUpdateTx(meta_in_state);
+  EXPECT_TRUE(pending_tx_tracker.IsNonceTaken(meta));
+
+  tx_state_manager.DeleteTx(meta_in_state.id());
+  EXPECT_FALSE(pending_tx_tracker.IsNonceTaken(meta));
 }
 
 TEST_F(EthPendingTxTrackerUnitTest, ShouldTxDropped) {
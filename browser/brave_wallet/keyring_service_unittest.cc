@@ -1378,6 +1378,85 @@ TEST_F(KeyringServiceUnitTest, LockAndUnlock) {
   }
 }
 
+TEST_F(KeyringServiceUnitTest, UnlockDerivesKeysOffTheCallingThread) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitWithFeatures(
+      {brave_wallet::features::kBraveWalletFilecoinFeature,
+       brave_wallet::features::kBraveWalletSolanaFeature},
+      {});
+
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  ASSERT_TRUE(AddAccount(&service, "SOL Account 1", mojom::CoinType::SOL));
+  service.Lock();
+
+  bool callback_called = false;
+  bool success = false;
+  base::RunLoop run_loop;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool v) {
+                   callback_called = true;
+                   success = v;
+                   run_loop.Quit();
+                 }));
+  // Unlock returns before any key is derived
+  EXPECT_FALSE(callback_called);
+  EXPECT_TRUE(service.IsLocked());
+  EXPECT_TRUE(service.IsLocked(mojom::kSolanaKeyringId));
+
+  run_loop.Run();
+  EXPECT_TRUE(success);
+  EXPECT_FALSE(service.IsLocked());
+  EXPECT_FALSE(service.IsLocked(mojom::kFilecoinKeyringId));
+  EXPECT_FALSE(service.IsLocked(mojom::kSolanaKeyringId));
+  EXPECT_EQ(
+      1u, service.GetAccountInfosForKeyring(mojom::kSolanaKeyringId).size());
+}
+
+TEST_F(KeyringServiceUnitTest, LockDuringUnlock) {
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  absl::optional<bool> success;
+  service.Unlock("brave", base::BindLambdaForTesting(
+                              [&](bool v) { success = v; }));
+  service.Lock();
+  // The unlock in progress fails right away and never unlocks the wallet
+  ASSERT_TRUE(success.has_value());
+  EXPECT_FALSE(*success);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(service.IsLocked());
+
+  // Same after a reset
+  success.reset();
+  service.Unlock("brave", base::BindLambdaForTesting(
+                              [&](bool v) { success = v; }));
+  service.Reset();
+  ASSERT_TRUE(success.has_value());
+  EXPECT_FALSE(*success);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(service.IsLocked());
+}
+
+TEST_F(KeyringServiceUnitTest, ConcurrentUnlocks) {
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  // Unlocks are answered in order, each with its own result
+  std::vector<bool> results;
+  base::RunLoop run_loop;
+  service.Unlock("wrong", base::BindLambdaForTesting(
+                              [&](bool v) { results.push_back(v); }));
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool v) {
+                   results.push_back(v);
+                   run_loop.Quit();
+                 }));
+  run_loop.Run();
+  EXPECT_EQ(results, std::vector<bool>({false, true}));
+  EXPECT_FALSE(service.IsLocked());
+}
+
 TEST_F(KeyringServiceUnitTest, Reset) {
   KeyringService service(json_rpc_service(), GetPrefs());
   ASSERT_TRUE(CreateWallet(&service, "brave"));
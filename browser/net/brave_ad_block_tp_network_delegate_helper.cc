@@ -19,6 +19,8 @@
 #include "brave/browser/brave_shields/ad_block_pref_service_factory.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/url_context.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_pref_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -70,7 +72,7 @@ struct EngineFlags {
   bool did_match_important = false;
 };
 
-void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
+void UseCnameResult(scoped_refptr<base::TaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
                     EngineFlags previous_result,
@@ -85,7 +87,7 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
  public:
   AdblockCnameResolveHostClient(
       const ResponseCallback& next_callback,
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      scoped_refptr<base::TaskRunner> task_runner,
       std::shared_ptr<BraveRequestInfo> ctx,
       EngineFlags previous_result) {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -168,6 +170,28 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   }
 };
 
+bool ShouldUseAggressiveBlocking(std::shared_ptr<BraveRequestInfo> ctx) {
+  bool force_aggressive = SameDomainOrHost(
+      ctx->initiator_url,
+      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
+      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  return ctx->aggressive_blocking || force_aggressive;
+}
+
+// Decisions for the original request URL are cached by the full source host
+// rather than its eTLD+1, since `$domain` filter options can target
+// individual subdomains.
+brave_shields::AdBlockDecisionCache::Key GetDecisionCacheKey(
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  return {ctx->request_url.spec(), ctx->resource_type,
+          ctx->initiator_url.host(), ShouldUseAggressiveBlocking(ctx)};
+}
+
+bool ShouldBlock(const EngineFlags& result) {
+  return result.did_match_important ||
+         (result.did_match_rule && !result.did_match_exception);
+}
+
 // If `canonical_url` is specified, this will only check if the CNAME-uncloaked
 // response should be blocked. Otherwise, it will run the check for the
 // original request URL.
@@ -187,21 +211,30 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
     url_to_check = ctx->request_url;
   }
 
-  bool force_aggressive = SameDomainOrHost(
-      ctx->initiator_url,
-      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
-      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  // Read before matching so that a result racing with an engine update is
+  // stored under the older generation and never served.
+  const uint64_t generation = brave_shields::AdBlockEngine::GetGeneration();
+
+  {
+    SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.ShouldBlockRequest");
+    g_brave_browser_process->ad_block_service()->ShouldStartRequest(
+        url_to_check, ctx->resource_type, source_host,
+        ShouldUseAggressiveBlocking(ctx), &previous_result.did_match_rule,
+        &previous_result.did_match_exception,
+        &previous_result.did_match_important, &ctx->mock_data_url);
+  }
 
-  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.ShouldBlockRequest");
-  g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-      url_to_check, ctx->resource_type, source_host,
-      ctx->aggressive_blocking || force_aggressive,
-      &previous_result.did_match_rule, &previous_result.did_match_exception,
-      &previous_result.did_match_important, &ctx->mock_data_url);
+  if (!canonical_url.has_value()) {
+    brave_shields::AdBlockDecisionCache::Decision decision;
+    decision.did_match_rule = previous_result.did_match_rule;
+    decision.did_match_exception = previous_result.did_match_exception;
+    decision.did_match_important = previous_result.did_match_important;
+    decision.mock_data_url = ctx->mock_data_url;
+    g_brave_browser_process->ad_block_service()->decision_cache()->Put(
+        GetDecisionCacheKey(ctx), decision, generation);
+  }
 
-  if (previous_result.did_match_important ||
-      (previous_result.did_match_rule &&
-       !previous_result.did_match_exception)) {
+  if (ShouldBlock(previous_result)) {
     ctx->blocked_by = kAdBlocked;
   }
 
@@ -210,7 +243,7 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
 
 void OnShouldBlockRequestResult(
     bool then_check_uncloaked,
-    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    scoped_refptr<base::TaskRunner> task_runner,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx,
     EngineFlags result) {
@@ -227,7 +260,7 @@ void OnShouldBlockRequestResult(
   next_callback.Run();
 }
 
-void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
+void UseCnameResult(scoped_refptr<base::TaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
                     EngineFlags previous_result,
@@ -297,15 +330,18 @@ bool ProxySettingsAllowUncloaking(content::BrowserContext* browser_context,
   return can_uncloak;
 }
 
-void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
-                                 std::shared_ptr<BraveRequestInfo> ctx) {
+// Returns net::OK or net::ERR_IO_PENDING, in the same way as
+// OnBeforeURLRequest_AdBlockTPPreWork.
+int OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
+                                std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   DCHECK_NE(ctx->request_identifier, 0UL);
   DCHECK(!ctx->request_url.is_empty());
   DCHECK(!ctx->initiator_url.is_empty());
 
-  scoped_refptr<base::SequencedTaskRunner> task_runner =
-      g_brave_browser_process->ad_block_service()->GetTaskRunner();
+  scoped_refptr<base::TaskRunner> task_runner =
+      g_brave_browser_process->ad_block_service()
+          ->GetRequestMatchingTaskRunner();
 
   SecureDnsConfig secure_dns_config =
       SystemNetworkContextManager::GetStubResolverConfigReader()
@@ -335,12 +371,41 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
     should_check_uncloaked = false;
   }
 
+  brave_shields::AdBlockDecisionCache::Decision decision;
+  const bool cache_hit =
+      g_brave_browser_process->ad_block_service()->decision_cache()->Get(
+          GetDecisionCacheKey(ctx),
+          brave_shields::AdBlockEngine::GetGeneration(), &decision);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.ShouldBlockRequest.CacheHit",
+                        cache_hit);
+  if (cache_hit) {
+    EngineFlags result;
+    result.did_match_rule = decision.did_match_rule;
+    result.did_match_exception = decision.did_match_exception;
+    result.did_match_important = decision.did_match_important;
+    ctx->mock_data_url = decision.mock_data_url;
+    if (ShouldBlock(result)) {
+      ctx->blocked_by = kAdBlocked;
+      brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
+          ctx->request_url, ctx->frame_tree_node_id, brave_shields::kAds);
+      return net::OK;
+    }
+    if (should_check_uncloaked) {
+      // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
+      new AdblockCnameResolveHostClient(next_callback, task_runner, ctx,
+                                        result);
+      return net::ERR_IO_PENDING;
+    }
+    return net::OK;
+  }
+
   task_runner->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, EngineFlags(),
                      absl::nullopt),
       base::BindOnce(&OnShouldBlockRequestResult, should_check_uncloaked,
                      task_runner, next_callback, ctx));
+  return net::ERR_IO_PENDING;
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
@@ -376,9 +441,7 @@ int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
     return net::OK;
   }
 
-  OnBeforeURLRequestAdBlockTP(next_callback, ctx);
-
-  return net::ERR_IO_PENDING;
+  return OnBeforeURLRequestAdBlockTP(next_callback, ctx);
 }
 
 }  // namespace brave
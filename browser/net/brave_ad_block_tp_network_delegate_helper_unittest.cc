@@ -227,6 +227,37 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, SimpleBlocking) {
   EXPECT_EQ(0ULL, host_resolver_->num_resolve());
 }
 
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, CachedDecision) {
+  ResetAdblockInstance("||brave.com/test.txt", "");
+
+  const GURL url("https://brave.com/test.txt");
+  auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  request_info->resource_type = blink::mojom::ResourceType::kScript;
+  request_info->initiator_url = GURL("https://bravesoftware.com");
+
+  EXPECT_TRUE(CheckRequest(request_info));
+  EXPECT_EQ(request_info->blocked_by, brave::kAdBlocked);
+
+  // The same request is now answered without a hop to the adblock task runner.
+  auto repeated_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  repeated_request_info->resource_type = blink::mojom::ResourceType::kScript;
+  repeated_request_info->initiator_url = GURL("https://bravesoftware.com");
+
+  EXPECT_FALSE(CheckRequest(repeated_request_info));
+  EXPECT_EQ(repeated_request_info->blocked_by, brave::kAdBlocked);
+
+  // Replacing the engine invalidates the cached decision.
+  ResetAdblockInstance("||example.com^", "");
+  task_environment_.RunUntilIdle();
+
+  auto updated_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  updated_request_info->resource_type = blink::mojom::ResourceType::kScript;
+  updated_request_info->initiator_url = GURL("https://bravesoftware.com");
+
+  EXPECT_TRUE(CheckRequest(updated_request_info));
+  EXPECT_EQ(updated_request_info->blocked_by, brave::kNotBlocked);
+}
+
 TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, Default1pException) {
   ResetAdblockInstance("||brave.com/test.txt", "");
 
@@ -13,6 +13,10 @@
 
 /**
  * Main adblocking engine that allows efficient querying of resources to block.
+ *
+ * Queries only need shared access, so they may run concurrently from any
+ * number of threads. Operations that modify the engine (tags, resources,
+ * deserialization) wait for in-flight queries to complete.
  */
 typedef struct C_Engine C_Engine;
 
@@ -89,6 +93,28 @@ void engine_match(struct C_Engine* engine,
                   bool* did_match_important,
                   char** redirect);
 
+/**
+ * Checks if a `url` matches for each of the `engines_len` engines in `engines`
+ * within the context, in a single call.
+ *
+ * Engines are checked in the order given, with the same semantics as repeated
+ * calls to `engine_match`: block results are carried from one engine to the
+ * next, a later redirect replaces an earlier one, and checking stops as soon
+ * as an `$important` rule is matched. The request strings only need to be
+ * converted once for all engines.
+ */
+void engines_match(struct C_Engine* const* engines,
+                   size_t engines_len,
+                   const char* url,
+                   const char* host,
+                   const char* tab_host,
+                   bool third_party,
+                   const char* resource_type,
+                   bool* did_match_rule,
+                   bool* did_match_exception,
+                   bool* did_match_important,
+                   char** redirect);
+
 /**
  * Returns any CSP directives that should be added to a subdocument or document
  * request's response headers.
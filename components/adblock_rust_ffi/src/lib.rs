@@ -1,5 +1,4 @@
 use adblock::blocker::Redirection;
-use adblock::engine::Engine;
 use adblock::lists::FilterListMetadata;
 use adblock::resources::{MimeType, Resource, ResourceType};
 use core::ptr;
@@ -8,6 +7,37 @@ use std::ffi::CStr;
 use std::ffi::CString;
 use std::os::raw::c_char;
 use std::string::String;
+use std::sync::{RwLock, RwLockReadGuard, RwLockWriteGuard};
+
+/// Main adblocking engine that allows efficient querying of resources to block.
+///
+/// Queries only need shared access, so they may run concurrently from any number of threads.
+/// Operations that modify the engine (tags, resources, deserialization) wait for in-flight queries
+/// to complete.
+pub struct Engine {
+    engine: RwLock<adblock::engine::Engine>,
+}
+
+impl Engine {
+    fn new(engine: adblock::engine::Engine) -> Self {
+        Self { engine: RwLock::new(engine) }
+    }
+
+    fn read(&self) -> RwLockReadGuard<'_, adblock::engine::Engine> {
+        self.engine.read().unwrap()
+    }
+
+    fn write(&self) -> RwLockWriteGuard<'_, adblock::engine::Engine> {
+        self.engine.write().unwrap()
+    }
+}
+
+// Sharing `Engine` across threads requires the underlying engine to be `Sync`, which rules out the
+// `object-pooling` and `unsync-regex-caching` features of the adblock crate.
+const _: fn() = || {
+    fn assert_sync<T: Sync>() {}
+    assert_sync::<adblock::engine::Engine>();
+};
 
 /// An external callback that receives a hostname and two out-parameters for start and end
 /// position. The callback should fill the start and end positions with the start and end indices
@@ -106,10 +136,10 @@ pub unsafe extern "C" fn engine_create_with_metadata(rules: *const c_char, metad
 fn engine_create_from_str(rules: &str) -> (*mut FilterListMetadata, *mut Engine) {
     let mut filter_set = adblock::lists::FilterSet::new(false);
     let metadata = filter_set.add_filter_list(&rules, Default::default());
-    let engine = Engine::from_filter_set(filter_set, true);
+    let engine = adblock::engine::Engine::from_filter_set(filter_set, true);
     (
         Box::into_raw(Box::new(metadata)),
-        Box::into_raw(Box::new(engine)),
+        Box::into_raw(Box::new(Engine::new(engine))),
     )
 }
 
@@ -136,7 +166,7 @@ pub unsafe extern "C" fn engine_match(
     let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
     let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let engine = (*engine).read();
     let blocker_result = engine.check_network_urls_with_hostnames_subset(
         url,
         host,
@@ -162,6 +192,69 @@ pub unsafe extern "C" fn engine_match(
     };
 }
 
+/// Checks if a `url` matches for each of the `engines_len` engines in `engines` within the
+/// context, in a single call.
+///
+/// Engines are checked in the order given, with the same semantics as repeated calls to
+/// `engine_match`: block results are carried from one engine to the next, a later redirect
+/// replaces an earlier one, and checking stops as soon as an `$important` rule is matched. The
+/// request strings only need to be converted once for all engines.
+#[no_mangle]
+pub unsafe extern "C" fn engines_match(
+    engines: *const *mut Engine,
+    engines_len: size_t,
+    url: *const c_char,
+    host: *const c_char,
+    tab_host: *const c_char,
+    third_party: bool,
+    resource_type: *const c_char,
+    did_match_rule: *mut bool,
+    did_match_exception: *mut bool,
+    did_match_important: *mut bool,
+    redirect: *mut *mut c_char,
+) {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    let host = CStr::from_ptr(host).to_str().unwrap();
+    let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
+    let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
+    assert!(engines_len == 0 || !engines.is_null());
+    let engines: &[*mut Engine] = if engines_len == 0 {
+        &[]
+    } else {
+        std::slice::from_raw_parts(engines, engines_len)
+    };
+    let mut redirect_resource: Option<String> = None;
+    for engine in engines {
+        assert!(!engine.is_null());
+        let engine = (**engine).read();
+        let blocker_result = engine.check_network_urls_with_hostnames_subset(
+            url,
+            host,
+            tab_host,
+            resource_type,
+            Some(third_party),
+            // Checking normal rules is skipped if a normal rule or exception rule was found previously
+            *did_match_rule || *did_match_exception,
+            // Always check exceptions unless one was found previously
+            !*did_match_exception,
+        );
+        *did_match_rule |= blocker_result.matched;
+        *did_match_exception |= blocker_result.exception.is_some();
+        *did_match_important |= blocker_result.important;
+        // Ignore `redirect-url` for now.
+        if let Some(Redirection::Resource(x)) = blocker_result.redirect {
+            redirect_resource = Some(x);
+        }
+        if *did_match_important {
+            break;
+        }
+    }
+    *redirect = match redirect_resource.map(CString::new) {
+        Some(Ok(y)) => y.into_raw(),
+        _ => ptr::null_mut(),
+    };
+}
+
 /// Returns any CSP directives that should be added to a subdocument or document request's response
 /// headers.
 #[no_mangle]
@@ -178,7 +271,7 @@ pub unsafe extern "C" fn engine_get_csp_directives(
     let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
     let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let engine = (*engine).read();
     if let Some(directive) =
         engine.get_csp_directives(url, host, tab_host, resource_type, Some(third_party))
     {
@@ -193,7 +286,7 @@ pub unsafe extern "C" fn engine_get_csp_directives(
 pub unsafe extern "C" fn engine_add_tag(engine: *mut Engine, tag: *const c_char) {
     let tag = CStr::from_ptr(tag).to_str().unwrap();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let mut engine = (*engine).write();
     engine.enable_tags(&[tag]);
 }
 
@@ -202,7 +295,7 @@ pub unsafe extern "C" fn engine_add_tag(engine: *mut Engine, tag: *const c_char)
 pub unsafe extern "C" fn engine_tag_exists(engine: *mut Engine, tag: *const c_char) -> bool {
     let tag = CStr::from_ptr(tag).to_str().unwrap();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let engine = (*engine).read();
     engine.tag_exists(tag)
 }
 
@@ -224,7 +317,7 @@ pub unsafe extern "C" fn engine_add_resource(
         content: data.to_string(),
     };
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let mut engine = (*engine).write();
     engine.add_resource(resource).is_ok()
 }
 
@@ -237,7 +330,7 @@ pub unsafe extern "C" fn engine_add_resources(engine: *mut Engine, resources: *c
         vec![]
     });
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let mut engine = (*engine).write();
     engine.use_resources(&resources);
 }
 
@@ -246,7 +339,7 @@ pub unsafe extern "C" fn engine_add_resources(engine: *mut Engine, resources: *c
 pub unsafe extern "C" fn engine_remove_tag(engine: *mut Engine, tag: *const c_char) {
     let tag = CStr::from_ptr(tag).to_str().unwrap();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let mut engine = (*engine).write();
     engine.disable_tags(&[tag]);
 }
 
@@ -259,7 +352,7 @@ pub unsafe extern "C" fn engine_deserialize(
 ) -> bool {
     let data: &[u8] = std::slice::from_raw_parts(data as *const u8, data_size);
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let mut engine = (*engine).write();
     let ok = engine.deserialize(&data).is_ok();
     if !ok {
         eprintln!("Error deserializing adblock engine");
@@ -333,7 +426,7 @@ pub unsafe extern "C" fn engine_url_cosmetic_resources(
 ) -> *mut c_char {
     let url = CStr::from_ptr(url).to_str().unwrap();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let engine = (*engine).read();
     CString::new(
         serde_json::to_string(&engine.url_cosmetic_resources(url)).unwrap_or_else(|_| "".into()),
     )
@@ -367,7 +460,7 @@ pub unsafe extern "C" fn engine_hidden_class_id_selectors(
         .map(|index| CStr::from_ptr(exceptions[index]).to_str().unwrap().to_owned())
         .collect();
     assert!(!engine.is_null());
-    let engine = Box::leak(Box::from_raw(engine));
+    let engine = (*engine).read();
     let stylesheet = engine.hidden_class_id_selectors(&classes, &ids, &exceptions);
     CString::new(serde_json::to_string(&stylesheet).unwrap_or_else(|_| "".into()))
         .expect("Error: CString::new()")
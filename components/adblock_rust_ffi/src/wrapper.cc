@@ -98,6 +98,36 @@ void Engine::matches(const std::string& url,
   }
 }
 
+// static
+void Engine::matchesAll(const std::vector<Engine*>& engines,
+                        const std::string& url,
+                        const std::string& host,
+                        const std::string& tab_host,
+                        bool is_third_party,
+                        const std::string& resource_type,
+                        bool* did_match_rule,
+                        bool* did_match_exception,
+                        bool* did_match_important,
+                        std::string* redirect) {
+  std::vector<C_Engine*> raw_engines;
+  raw_engines.reserve(engines.size());
+  for (Engine* engine : engines) {
+    raw_engines.push_back(engine->raw);
+  }
+
+  char* redirect_char_ptr = nullptr;
+  engines_match(raw_engines.data(), raw_engines.size(), url.c_str(),
+                host.c_str(), tab_host.c_str(), is_third_party,
+                resource_type.c_str(), did_match_rule, did_match_exception,
+                did_match_important, &redirect_char_ptr);
+  if (redirect_char_ptr) {
+    if (redirect) {
+      *redirect = redirect_char_ptr;
+    }
+    c_char_buffer_destroy(redirect_char_ptr);
+  }
+}
+
 std::string Engine::getCspDirectives(const std::string& url,
                                      const std::string& host,
                                      const std::string& tab_host,
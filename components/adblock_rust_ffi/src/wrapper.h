@@ -75,6 +75,19 @@ class ADBLOCK_EXPORT Engine {
                bool* did_match_exception,
                bool* did_match_important,
                std::string* redirect);
+  // Checks |url| against each of |engines| in order with a single call into
+  // the library. Results are accumulated exactly as if matches() had been
+  // called on each engine in turn, stopping at the first important match.
+  static void matchesAll(const std::vector<Engine*>& engines,
+                         const std::string& url,
+                         const std::string& host,
+                         const std::string& tab_host,
+                         bool is_third_party,
+                         const std::string& resource_type,
+                         bool* did_match_rule,
+                         bool* did_match_exception,
+                         bool* did_match_important,
+                         std::string* redirect);
   std::string getCspDirectives(const std::string& url,
                                const std::string& host,
                                const std::string& tab_host,
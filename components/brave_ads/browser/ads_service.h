@@ -118,11 +118,20 @@ class AdsService : public KeyedService {
   // Called when a resource component has been updated.
   virtual void OnDidUpdateResourceComponent(const std::string& id) = 0;
 
+  // Called to find out whether the page with |redirect_chain| must be sent as
+  // HTML to |OnTabHtmlContentDidChange|. The callback takes one argument -
+  // |bool| is set to |false| if the markup of the <meta> elements of the page
+  // is enough.
+  virtual void IsFullHtmlContentNeeded(
+      const std::vector<GURL>& redirect_chain,
+      IsFullHtmlContentNeededCallback callback) = 0;
+
   // Called when the page for |tab_id| has loaded and the content is available
   // for analysis. |redirect_chain| containing a list of redirect URLs that
   // occurred on the way to the current page. The current page is the last one
   // in the list (so even when there's no redirect, there should be one entry in
-  // the list). |html| containing the page content as HTML.
+  // the list). |html| containing the page content as HTML, or only the markup
+  // of its <meta> elements if |IsFullHtmlContentNeeded| returned |false|.
   virtual void OnTabHtmlContentDidChange(
       const SessionID& tab_id,
       const std::vector<GURL>& redirect_chain,
@@ -132,7 +141,8 @@ class AdsService : public KeyedService {
   // for analysis. |redirect_chain| containing a list of redirect URLs that
   // occurred on the way to the current page. The current page is the last one
   // in the list (so even when there's no redirect, there should be one entry in
-  // the list). |text| containing the page content as text.
+  // the list). |text| containing the page content as text. Only the first 32768
+  // bytes of |text| are classified, so callers need not send more than that.
   virtual void OnTabTextContentDidChange(
       const SessionID& tab_id,
       const std::vector<GURL>& redirect_chain,
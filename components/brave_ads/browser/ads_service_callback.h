@@ -18,6 +18,8 @@ namespace brave_ads {
 using GetDiagnosticsCallback =
     base::OnceCallback<void(absl::optional<base::Value::List>)>;
 
+using IsFullHtmlContentNeededCallback = base::OnceCallback<void(bool)>;
+
 using GetStatementOfAccountsCallback =
     base::OnceCallback<void(ads::mojom::StatementInfoPtr)>;
 
@@ -1106,6 +1106,17 @@ void AdsServiceImpl::OnLocaleDidChange(const std::string& locale) {
   bat_ads_->OnLocaleDidChange(locale);
 }
 
+void AdsServiceImpl::IsFullHtmlContentNeeded(
+    const std::vector<GURL>& redirect_chain,
+    IsFullHtmlContentNeededCallback callback) {
+  if (!IsBatAdsBound()) {
+    std::move(callback).Run(/*is_needed*/ false);
+    return;
+  }
+
+  bat_ads_->IsFullHtmlContentNeeded(redirect_chain, std::move(callback));
+}
+
 void AdsServiceImpl::OnTabHtmlContentDidChange(
     const SessionID& tab_id,
     const std::vector<GURL>& redirect_chain,
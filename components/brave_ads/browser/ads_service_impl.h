@@ -258,6 +258,9 @@ class AdsServiceImpl : public AdsService,
 
   void OnLocaleDidChange(const std::string& locale) override;
 
+  void IsFullHtmlContentNeeded(
+      const std::vector<GURL>& redirect_chain,
+      IsFullHtmlContentNeededCallback callback) override;
   void OnTabHtmlContentDidChange(const SessionID& tab_id,
                                  const std::vector<GURL>& redirect_chain,
                                  const std::string& html) override;
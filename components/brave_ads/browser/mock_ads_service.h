@@ -54,6 +54,8 @@ class MockAdsService : public AdsService {
 
   MOCK_METHOD1(OnDidUpdateResourceComponent, void(const std::string&));
 
+  MOCK_METHOD2(IsFullHtmlContentNeeded,
+               void(const std::vector<GURL>&, IsFullHtmlContentNeededCallback));
   MOCK_METHOD3(OnTabHtmlContentDidChange,
                void(const SessionID&,
                     const std::vector<GURL>&,
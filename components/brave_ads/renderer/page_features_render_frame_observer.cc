@@ -0,0 +1,176 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/renderer/page_features_render_frame_observer.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "content/public/renderer/render_frame.h"
+#include "gin/converter.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+#include "third_party/blink/public/platform/web_string.h"
+#include "third_party/blink/public/web/blink.h"
+#include "third_party/blink/public/web/web_document.h"
+#include "third_party/blink/public/web/web_element.h"
+#include "third_party/blink/public/web/web_element_collection.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+#include "third_party/blink/public/web/web_script_source.h"
+#include "v8/include/v8.h"
+
+namespace brave_ads {
+
+namespace {
+
+// Truncates the text in the page so that only a prefix is converted to UTF-8.
+// Each UTF-16 code unit takes at least one UTF-8 byte, so this never drops
+// text that would fit in |mojom::kMaxPageTextSize| bytes.
+constexpr char kExtractTextScript[] =
+    "document?.body?.innerText?.substring(0, %u)";
+
+// Escapes an attribute value as XMLSerializer does, so that consumers see the
+// same markup as for a serialized document.
+std::string EscapeAttributeValue(const std::string& value) {
+  std::string escaped_value;
+  escaped_value.reserve(value.size());
+  for (const char c : value) {
+    switch (c) {
+      case '&': {
+        escaped_value += "&amp;";
+        break;
+      }
+
+      case '"': {
+        escaped_value += "&quot;";
+        break;
+      }
+
+      case '<': {
+        escaped_value += "&lt;";
+        break;
+      }
+
+      case '>': {
+        escaped_value += "&gt;";
+        break;
+      }
+
+      case '\t': {
+        escaped_value += "&#9;";
+        break;
+      }
+
+      case '\n': {
+        escaped_value += "&#10;";
+        break;
+      }
+
+      case '\r': {
+        escaped_value += "&#13;";
+        break;
+      }
+
+      default: {
+        escaped_value += c;
+        break;
+      }
+    }
+  }
+
+  return escaped_value;
+}
+
+std::string SerializeMetaElement(const blink::WebElement& element) {
+  std::string html = "<meta";
+  for (unsigned i = 0; i < element.AttributeCount(); i++) {
+    base::StrAppend(
+        &html, {" ", element.AttributeLocalName(i).Utf8(), "=\"",
+                EscapeAttributeValue(element.AttributeValue(i).Utf8()), "\""});
+  }
+  html += " />";
+
+  return html;
+}
+
+std::string SerializeMetaElements(const blink::WebDocument& document) {
+  std::vector<std::string> meta_elements;
+
+  blink::WebElementCollection elements =
+      document.GetElementsByHTMLTagName("meta");
+  for (blink::WebElement element = elements.FirstItem(); !element.IsNull();
+       element = elements.NextItem()) {
+    meta_elements.push_back(SerializeMetaElement(element));
+  }
+
+  return base::JoinString(meta_elements, "\n");
+}
+
+}  // namespace
+
+PageFeaturesRenderFrameObserver::PageFeaturesRenderFrameObserver(
+    content::RenderFrame* render_frame,
+    const int32_t isolated_world_id)
+    : RenderFrameObserver(render_frame), isolated_world_id_(isolated_world_id) {
+  render_frame->GetAssociatedInterfaceRegistry()
+      ->AddInterface<mojom::PageFeaturesExtractor>(base::BindRepeating(
+          &PageFeaturesRenderFrameObserver::BindReceiver,
+          base::Unretained(this)));
+}
+
+PageFeaturesRenderFrameObserver::~PageFeaturesRenderFrameObserver() = default;
+
+void PageFeaturesRenderFrameObserver::ExtractMetaHtml(
+    ExtractMetaHtmlCallback callback) {
+  const blink::WebDocument document =
+      render_frame()->GetWebFrame()->GetDocument();
+  if (document.IsNull()) {
+    std::move(callback).Run(/*meta_html*/ {});
+    return;
+  }
+
+  std::move(callback).Run(SerializeMetaElements(document));
+}
+
+void PageFeaturesRenderFrameObserver::ExtractText(
+    ExtractTextCallback callback) {
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  const v8::Local<v8::Value> value =
+      render_frame()->GetWebFrame()->ExecuteScriptInIsolatedWorldAndReturnValue(
+          isolated_world_id_,
+          blink::WebScriptSource(blink::WebString::FromUTF8(
+              base::StringPrintf(kExtractTextScript, mojom::kMaxPageTextSize))),
+          blink::BackForwardCacheAware::kAllow);
+
+  std::string text;
+  if (value.IsEmpty() || !value->IsString() ||
+      !gin::ConvertFromV8(isolate, value, &text)) {
+    std::move(callback).Run(/*text*/ {});
+    return;
+  }
+
+  base::TruncateUTF8ToByteSize(text, mojom::kMaxPageTextSize, &text);
+  std::move(callback).Run(text);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PageFeaturesRenderFrameObserver::BindReceiver(
+    mojo::PendingAssociatedReceiver<mojom::PageFeaturesExtractor> receiver) {
+  receiver_.reset();
+  receiver_.Bind(std::move(receiver));
+}
+
+void PageFeaturesRenderFrameObserver::OnDestruct() {
+  delete this;
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,58 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_PAGE_FEATURES_RENDER_FRAME_OBSERVER_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_PAGE_FEATURES_RENDER_FRAME_OBSERVER_H_
+
+#include <cstdint>
+
+#include "brave/components/brave_ads/common/page_features_extractor.mojom.h"
+#include "content/public/renderer/render_frame_observer.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+
+namespace content {
+class RenderFrame;
+}  // namespace content
+
+namespace brave_ads {
+
+// Extracts the <meta> elements and a bounded prefix of the text of the main
+// frame document, which are all that ads targeting and conversions read from
+// most pages, so that the browser does not have to serialize the whole document
+// or its text and copy them to the ads service.
+class PageFeaturesRenderFrameObserver final
+    : public content::RenderFrameObserver,
+      public mojom::PageFeaturesExtractor {
+ public:
+  PageFeaturesRenderFrameObserver(content::RenderFrame* render_frame,
+                                  int32_t isolated_world_id);
+
+  PageFeaturesRenderFrameObserver(const PageFeaturesRenderFrameObserver&) =
+      delete;
+  PageFeaturesRenderFrameObserver& operator=(
+      const PageFeaturesRenderFrameObserver&) = delete;
+
+  ~PageFeaturesRenderFrameObserver() override;
+
+  // mojom::PageFeaturesExtractor:
+  void ExtractMetaHtml(ExtractMetaHtmlCallback callback) override;
+  void ExtractText(ExtractTextCallback callback) override;
+
+ private:
+  void BindReceiver(
+      mojo::PendingAssociatedReceiver<mojom::PageFeaturesExtractor> receiver);
+
+  // content::RenderFrameObserver:
+  void OnDestruct() override;
+
+  const int32_t isolated_world_id_;
+
+  mojo::AssociatedReceiver<mojom::PageFeaturesExtractor> receiver_{this};
+};
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_PAGE_FEATURES_RENDER_FRAME_OBSERVER_H_
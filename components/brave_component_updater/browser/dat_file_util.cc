@@ -7,10 +7,12 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "base/logging.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace {
 
@@ -39,12 +41,40 @@ void GetDATFileData(const base::FilePath& file_path,
 
 namespace brave_component_updater {
 
+DATFileData::DATFileData(DATFileDataBuffer buffer)
+    : buffer_(std::move(buffer)) {}
+
+DATFileData::DATFileData(std::unique_ptr<base::MemoryMappedFile> mapped_file)
+    : mapped_file_(std::move(mapped_file)) {
+  DCHECK(mapped_file_ && mapped_file_->IsValid());
+}
+
+DATFileData::~DATFileData() = default;
+
+base::span<const uint8_t> DATFileData::bytes() const {
+  if (mapped_file_) {
+    return base::make_span(mapped_file_->data(), mapped_file_->length());
+  }
+  return base::make_span(buffer_.data(), buffer_.size());
+}
+
 DATFileDataBuffer ReadDATFileData(const base::FilePath& dat_file_path) {
   DATFileDataBuffer buffer;
   GetDATFileData(dat_file_path, &buffer);
   return buffer;
 }
 
+scoped_refptr<DATFileData> MapDATFileData(
+    const base::FilePath& dat_file_path) {
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(dat_file_path) || !mapped_file->length()) {
+    LOG(ERROR) << "MapDATFileData: cannot "
+               << "map dat file " << dat_file_path;
+    return base::MakeRefCounted<DATFileData>(DATFileDataBuffer());
+  }
+  return base::MakeRefCounted<DATFileData>(std::move(mapped_file));
+}
+
 std::string GetDATFileAsString(const base::FilePath& file_path) {
   std::string contents;
   bool success = base::ReadFileToString(file_path, &contents);
@@ -6,21 +6,55 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class MemoryMappedFile;
+}  // namespace base
 
 namespace brave_component_updater {
 
 using DATFileDataBuffer = std::vector<unsigned char>;
 
+// Read-only contents of a DAT file that can be handed between threads without
+// copying. Data loaded with MapDATFileData is backed by a read-only memory
+// mapping, so it is never copied onto the heap and its pages can be shared with
+// other mappings of the same file.
+class DATFileData : public base::RefCountedThreadSafe<DATFileData> {
+ public:
+  explicit DATFileData(DATFileDataBuffer buffer);
+  explicit DATFileData(std::unique_ptr<base::MemoryMappedFile> mapped_file);
+  DATFileData(const DATFileData&) = delete;
+  DATFileData& operator=(const DATFileData&) = delete;
+
+  base::span<const uint8_t> bytes() const;
+  bool empty() const { return bytes().empty(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<DATFileData>;
+  ~DATFileData();
+
+  const DATFileDataBuffer buffer_;
+  const std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+};
+
 std::string GetDATFileAsString(const base::FilePath& file_path);
 
 DATFileDataBuffer ReadDATFileData(const base::FilePath& dat_file_path);
 
+// Like ReadDATFileData, but maps the file instead of reading it. Returns empty
+// data if the file can't be mapped.
+scoped_refptr<DATFileData> MapDATFileData(const base::FilePath& dat_file_path);
+
 template <typename T>
 using LoadDATFileDataResult =
     std::pair<std::unique_ptr<T>, brave_component_updater::DATFileDataBuffer>;
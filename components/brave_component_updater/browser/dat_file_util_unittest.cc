@@ -0,0 +1,65 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "base/ranges/algorithm.h"
+#include "brave/components/constants/brave_paths.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_component_updater {
+
+class DATFileUtilTest : public ::testing::Test {
+ public:
+  DATFileUtilTest() = default;
+  ~DATFileUtilTest() override = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir_));
+    test_data_dir_ = test_data_dir_.AppendASCII("adblock-data");
+  }
+
+ protected:
+  base::FilePath test_data_dir_;
+};
+
+TEST_F(DATFileUtilTest, MapMatchesRead) {
+  const base::FilePath kBundledLists[] = {
+      test_data_dir_.AppendASCII("adblock-default").AppendASCII("list.txt"),
+      test_data_dir_.AppendASCII("adblock-regional").AppendASCII("list.txt"),
+      test_data_dir_.AppendASCII("redirect-rule.dat"),
+  };
+
+  for (const auto& path : kBundledLists) {
+    const DATFileDataBuffer buffer = ReadDATFileData(path);
+    ASSERT_FALSE(buffer.empty()) << path;
+
+    scoped_refptr<DATFileData> mapped = MapDATFileData(path);
+    ASSERT_FALSE(mapped->empty()) << path;
+    EXPECT_TRUE(base::ranges::equal(buffer, mapped->bytes())) << path;
+  }
+}
+
+TEST_F(DATFileUtilTest, MapMissingFile) {
+  scoped_refptr<DATFileData> mapped =
+      MapDATFileData(test_data_dir_.AppendASCII("does-not-exist.dat"));
+  ASSERT_TRUE(mapped);
+  EXPECT_TRUE(mapped->empty());
+}
+
+TEST_F(DATFileUtilTest, Buffer) {
+  auto data = base::MakeRefCounted<DATFileData>(DATFileDataBuffer{1, 2, 3});
+  EXPECT_FALSE(data->empty());
+  EXPECT_EQ(data->bytes().size(), 3u);
+  EXPECT_EQ(data->bytes()[2], 3);
+
+  EXPECT_TRUE(base::MakeRefCounted<DATFileData>(DATFileDataBuffer())->empty());
+}
+
+}  // namespace brave_component_updater
@@ -52,16 +52,18 @@ void AdBlockComponentFiltersProvider::OnComponentReady(
 
   base::FilePath list_file_path = component_path_.AppendASCII(kListFile);
 
-  // Load the list as a string
+  // Map the list rather than reading it, it's only needed until the engine has
+  // been built from it.
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::ReadDATFileData, list_file_path),
+      base::BindOnce(&brave_component_updater::MapDATFileData, list_file_path),
       base::BindOnce(&AdBlockComponentFiltersProvider::OnDATLoaded,
                      weak_factory_.GetWeakPtr(), false));
 }
 
 void AdBlockComponentFiltersProvider::LoadDATBuffer(
-    base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
+    base::OnceCallback<void(bool deserialize,
+                            scoped_refptr<DATFileData> dat_data)>
         cb) {
   if (component_path_.empty()) {
     // If the path is not ready yet, don't run the callback. An update should
@@ -73,7 +75,7 @@ void AdBlockComponentFiltersProvider::LoadDATBuffer(
 
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::ReadDATFileData, list_file_path),
+      base::BindOnce(&brave_component_updater::MapDATFileData, list_file_path),
       base::BindOnce(std::move(cb), false));
 }
 
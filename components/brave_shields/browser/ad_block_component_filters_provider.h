@@ -14,7 +14,7 @@
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
-using brave_component_updater::DATFileDataBuffer;
+using brave_component_updater::DATFileData;
 
 namespace component_updater {
 class ComponentUpdateService;
@@ -50,7 +50,7 @@ class AdBlockComponentFiltersProvider : public AdBlockFiltersProvider {
 
   void LoadDATBuffer(
       base::OnceCallback<void(bool deserialize,
-                              const DATFileDataBuffer& dat_buf)>) override;
+                              scoped_refptr<DATFileData> dat_data)>) override;
 
   bool Delete() && override;
 
@@ -36,13 +36,14 @@ bool AdBlockCustomFiltersProvider::UpdateCustomFilters(
 
   auto buffer =
       std::vector<unsigned char>(custom_filters.begin(), custom_filters.end());
-  OnDATLoaded(false, buffer);
+  OnDATLoaded(false, base::MakeRefCounted<DATFileData>(std::move(buffer)));
 
   return true;
 }
 
 void AdBlockCustomFiltersProvider::LoadDATBuffer(
-    base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
+    base::OnceCallback<void(bool deserialize,
+                            scoped_refptr<DATFileData> dat_data)>
         cb) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   auto custom_filters = GetCustomFilters();
@@ -52,7 +53,9 @@ void AdBlockCustomFiltersProvider::LoadDATBuffer(
 
   // PostTask so this has an async return to match other loaders
   base::ThreadTaskRunnerHandle::Get()->PostTask(
-      FROM_HERE, base::BindOnce(std::move(cb), false, std::move(buffer)));
+      FROM_HERE,
+      base::BindOnce(std::move(cb), false,
+                     base::MakeRefCounted<DATFileData>(std::move(buffer))));
 }
 
 }  // namespace brave_shields
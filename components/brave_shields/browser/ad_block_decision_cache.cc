@@ -0,0 +1,66 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include <tuple>
+
+#include "base/check.h"
+
+namespace brave_shields {
+
+bool AdBlockDecisionCache::Key::operator<(const Key& other) const {
+  return std::tie(url, resource_type, tab_host, aggressive_blocking) <
+         std::tie(other.url, other.resource_type, other.tab_host,
+                  other.aggressive_blocking);
+}
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t max_size)
+    : data_(max_size) {}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() = default;
+
+bool AdBlockDecisionCache::Get(const Key& key,
+                               uint64_t generation,
+                               Decision* decision) {
+  DCHECK(decision);
+  base::AutoLock lock(lock_);
+  if (!UpdateGenerationLocked(generation)) {
+    return false;
+  }
+
+  auto it = data_.Get(key);
+  if (it == data_.end()) {
+    return false;
+  }
+
+  *decision = it->second;
+  return true;
+}
+
+void AdBlockDecisionCache::Put(const Key& key,
+                               const Decision& decision,
+                               uint64_t generation) {
+  base::AutoLock lock(lock_);
+  if (!UpdateGenerationLocked(generation)) {
+    return;
+  }
+
+  data_.Put(key, decision);
+}
+
+bool AdBlockDecisionCache::UpdateGenerationLocked(uint64_t generation) {
+  if (generation < generation_) {
+    return false;
+  }
+
+  if (generation > generation_) {
+    data_.Clear();
+    generation_ = generation;
+  }
+  return true;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,70 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+namespace brave_shields {
+
+// Bounded cache of network blocking decisions, so that requests which were
+// checked recently can skip the hop to the adblock task runner. Entries are
+// tagged with the engine generation (see AdBlockEngine::GetGeneration) they
+// were computed with, and the whole cache is dropped as soon as a newer
+// generation is seen. Safe to use from any thread.
+class AdBlockDecisionCache {
+ public:
+  static constexpr size_t kDefaultMaxSize = 1000;
+
+  struct Key {
+    std::string url;
+    blink::mojom::ResourceType resource_type;
+    std::string tab_host;
+    bool aggressive_blocking;
+
+    bool operator<(const Key& other) const;
+  };
+
+  struct Decision {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+  };
+
+  explicit AdBlockDecisionCache(size_t max_size = kDefaultMaxSize);
+  AdBlockDecisionCache(const AdBlockDecisionCache&) = delete;
+  AdBlockDecisionCache& operator=(const AdBlockDecisionCache&) = delete;
+  ~AdBlockDecisionCache();
+
+  // Returns true and fills |decision| if a decision for |key| was cached with
+  // the current |generation|.
+  bool Get(const Key& key, uint64_t generation, Decision* decision);
+  // Stores |decision| for |key|. Decisions computed with an outdated
+  // |generation| are ignored.
+  void Put(const Key& key, const Decision& decision, uint64_t generation);
+
+ private:
+  // Returns false if |generation| is older than the cached entries.
+  bool UpdateGenerationLocked(uint64_t generation)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  base::Lock lock_;
+  uint64_t generation_ GUARDED_BY(lock_) = 0;
+  base::LRUCache<Key, Decision> data_ GUARDED_BY(lock_);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
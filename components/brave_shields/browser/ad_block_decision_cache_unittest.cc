@@ -0,0 +1,86 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+AdBlockDecisionCache::Key MakeKey(const std::string& url) {
+  return {url, blink::mojom::ResourceType::kScript, "example.com", false};
+}
+
+AdBlockDecisionCache::Decision MakeBlockDecision() {
+  AdBlockDecisionCache::Decision decision;
+  decision.did_match_rule = true;
+  decision.mock_data_url = "data:text/javascript,";
+  return decision;
+}
+
+}  // namespace
+
+TEST(AdBlockDecisionCacheTest, PutAndGet) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecisionCache::Decision decision;
+
+  EXPECT_FALSE(cache.Get(MakeKey("https://a.com/ad.js"), 1, &decision));
+
+  cache.Put(MakeKey("https://a.com/ad.js"), MakeBlockDecision(), 1);
+  ASSERT_TRUE(cache.Get(MakeKey("https://a.com/ad.js"), 1, &decision));
+  EXPECT_TRUE(decision.did_match_rule);
+  EXPECT_FALSE(decision.did_match_exception);
+  EXPECT_FALSE(decision.did_match_important);
+  EXPECT_EQ(decision.mock_data_url, "data:text/javascript,");
+
+  // Every part of the key is significant.
+  AdBlockDecisionCache::Key key = MakeKey("https://a.com/ad.js");
+  key.resource_type = blink::mojom::ResourceType::kImage;
+  EXPECT_FALSE(cache.Get(key, 1, &decision));
+  key = MakeKey("https://a.com/ad.js");
+  key.tab_host = "sub.example.com";
+  EXPECT_FALSE(cache.Get(key, 1, &decision));
+  key = MakeKey("https://a.com/ad.js");
+  key.aggressive_blocking = true;
+  EXPECT_FALSE(cache.Get(key, 1, &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, MaxSize) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecisionCache::Decision decision;
+
+  cache.Put(MakeKey("https://a.com/"), MakeBlockDecision(), 1);
+  cache.Put(MakeKey("https://b.com/"), MakeBlockDecision(), 1);
+  // a.com becomes the most recently used entry, so b.com is evicted next.
+  EXPECT_TRUE(cache.Get(MakeKey("https://a.com/"), 1, &decision));
+  cache.Put(MakeKey("https://c.com/"), MakeBlockDecision(), 1);
+
+  EXPECT_TRUE(cache.Get(MakeKey("https://a.com/"), 1, &decision));
+  EXPECT_FALSE(cache.Get(MakeKey("https://b.com/"), 1, &decision));
+  EXPECT_TRUE(cache.Get(MakeKey("https://c.com/"), 1, &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, GenerationInvalidation) {
+  AdBlockDecisionCache cache;
+  AdBlockDecisionCache::Decision decision;
+
+  cache.Put(MakeKey("https://a.com/"), MakeBlockDecision(), 1);
+  EXPECT_TRUE(cache.Get(MakeKey("https://a.com/"), 1, &decision));
+
+  // A newer generation drops everything cached so far.
+  EXPECT_FALSE(cache.Get(MakeKey("https://a.com/"), 2, &decision));
+  EXPECT_FALSE(cache.Get(MakeKey("https://a.com/"), 1, &decision));
+
+  // Results computed against an outdated engine are not stored.
+  cache.Put(MakeKey("https://b.com/"), MakeBlockDecision(), 1);
+  EXPECT_FALSE(cache.Get(MakeKey("https://b.com/"), 2, &decision));
+
+  cache.Put(MakeKey("https://b.com/"), MakeBlockDecision(), 2);
+  EXPECT_TRUE(cache.Get(MakeKey("https://b.com/"), 2, &decision));
+}
+
+}  // namespace brave_shields
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <utility>
@@ -28,6 +29,8 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+std::atomic<uint64_t> g_engine_generation{0};
+
 std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -98,7 +101,16 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
 
 namespace brave_shields {
 
-AdBlockEngine::AdBlockEngine() : ad_block_client_(new adblock::Engine()) {}
+AdBlockEngine::Client::Client(std::unique_ptr<adblock::Engine> engine)
+    : engine_(std::move(engine)) {
+  DCHECK(engine_);
+}
+
+AdBlockEngine::Client::~Client() = default;
+
+AdBlockEngine::AdBlockEngine()
+    : ad_block_client_(base::MakeRefCounted<Client>(
+          std::make_unique<adblock::Engine>())) {}
 
 AdBlockEngine::~AdBlockEngine() = default;
 
@@ -117,10 +129,11 @@ void AdBlockEngine::ShouldStartRequest(const GURL& url,
       url,
       url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
       INCLUDE_PRIVATE_REGISTRIES);
-  ad_block_client_->matches(url.spec(), url.host(), tab_host, is_third_party,
-                            ResourceTypeToString(resource_type), did_match_rule,
-                            did_match_exception, did_match_important,
-                            mock_data_url);
+  GetClient()->engine()->matches(url.spec(), url.host(), tab_host,
+                                 is_third_party,
+                                 ResourceTypeToString(resource_type),
+                                 did_match_rule, did_match_exception,
+                                 did_match_important, mock_data_url);
 
   // LOG(ERROR) << "AdBlockEngine::ShouldStartRequest(), host: "
   //  << tab_host
@@ -128,6 +141,38 @@ void AdBlockEngine::ShouldStartRequest(const GURL& url,
   //  << ", url.spec(): " << url.spec();
 }
 
+// static
+void AdBlockEngine::ShouldStartRequestInClients(
+    const std::vector<scoped_refptr<Client>>& clients,
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
+  if (clients.empty()) {
+    return;
+  }
+
+  std::vector<adblock::Engine*> ad_block_clients;
+  ad_block_clients.reserve(clients.size());
+  for (const auto& client : clients) {
+    ad_block_clients.push_back(client->engine());
+  }
+
+  bool is_third_party = !SameDomainOrHost(
+      url,
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+  adblock::Engine::matchesAll(ad_block_clients, url.spec(), url.host(),
+                              tab_host, is_third_party,
+                              ResourceTypeToString(resource_type),
+                              did_match_rule, did_match_exception,
+                              did_match_important, mock_data_url);
+}
+
 absl::optional<std::string> AdBlockEngine::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -139,7 +184,7 @@ absl::optional<std::string> AdBlockEngine::GetCspDirectives(
       url,
       url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
       INCLUDE_PRIVATE_REGISTRIES);
-  const std::string result = ad_block_client_->getCspDirectives(
+  const std::string result = GetClient()->engine()->getCspDirectives(
       url.spec(), url.host(), tab_host, is_third_party,
       ResourceTypeToString(resource_type));
 
@@ -153,26 +198,46 @@ absl::optional<std::string> AdBlockEngine::GetCspDirectives(
 void AdBlockEngine::EnableTag(const std::string& tag, bool enabled) {
   if (enabled) {
     if (tags_.find(tag) == tags_.end()) {
-      ad_block_client_->addTag(tag);
+      GetClient()->engine()->addTag(tag);
       tags_.insert(tag);
+      IncrementGeneration();
     }
   } else {
-    ad_block_client_->removeTag(tag);
-    tags_.erase(tag);
+    GetClient()->engine()->removeTag(tag);
+    if (tags_.erase(tag)) {
+      IncrementGeneration();
+    }
   }
 }
 
 void AdBlockEngine::AddResources(const std::string& resources) {
-  ad_block_client_->addResources(resources);
+  GetClient()->engine()->addResources(resources);
+  IncrementGeneration();
 }
 
 bool AdBlockEngine::TagExists(const std::string& tag) {
   return base::Contains(tags_, tag);
 }
 
+scoped_refptr<AdBlockEngine::Client> AdBlockEngine::GetClient() {
+  base::AutoLock lock(ad_block_client_lock_);
+  return ad_block_client_;
+}
+
+// static
+uint64_t AdBlockEngine::GetGeneration() {
+  return g_engine_generation.load();
+}
+
+// static
+void AdBlockEngine::IncrementGeneration() {
+  ++g_engine_generation;
+}
+
 absl::optional<base::Value> AdBlockEngine::UrlCosmeticResources(
     const std::string& url) {
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  return base::JSONReader::Read(
+      GetClient()->engine()->urlCosmeticResources(url));
 }
 
 base::Value::List AdBlockEngine::HiddenClassIdSelectors(
@@ -180,7 +245,7 @@ base::Value::List AdBlockEngine::HiddenClassIdSelectors(
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
   absl::optional<base::Value> result = base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+      GetClient()->engine()->hiddenClassIdSelectors(classes, ids, exceptions));
 
   if (!result) {
     return base::Value::List();
@@ -192,51 +257,63 @@ base::Value::List AdBlockEngine::HiddenClassIdSelectors(
 
 absl::optional<adblock::FilterListMetadata> AdBlockEngine::Load(
     bool deserialize,
-    const DATFileDataBuffer& dat_buf,
+    const DATFileData& dat_data,
     const std::string& resources_json) {
   if (deserialize) {
-    OnDATLoaded(dat_buf, resources_json);
+    OnDATLoaded(dat_data, resources_json);
     return absl::nullopt;
   } else {
-    return absl::make_optional(OnListSourceLoaded(dat_buf, resources_json));
+    return absl::make_optional(OnListSourceLoaded(dat_data, resources_json));
   }
 }
 
 void AdBlockEngine::UpdateAdBlockClient(
     std::unique_ptr<adblock::Engine> ad_block_client,
     const std::string& resources_json) {
-  ad_block_client_ = std::move(ad_block_client);
-  AddResources(resources_json);
-  AddKnownTagsToAdBlockInstance();
+  // The new engine is fully set up before it is published, since queries from
+  // other threads can pick it up immediately.
+  ad_block_client->addResources(resources_json);
+  for (const auto& tag : tags_) {
+    ad_block_client->addTag(tag);
+  }
+  {
+    base::AutoLock lock(ad_block_client_lock_);
+    ad_block_client_ =
+        base::MakeRefCounted<Client>(std::move(ad_block_client));
+  }
+  IncrementGeneration();
   if (test_observer_) {
     test_observer_->OnEngineUpdated();
   }
 }
 
 void AdBlockEngine::AddKnownTagsToAdBlockInstance() {
-  std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+  scoped_refptr<Client> client = GetClient();
+  std::for_each(tags_.begin(), tags_.end(), [&](const std::string tag) {
+    client->engine()->addTag(tag);
+  });
 }
 
 adblock::FilterListMetadata AdBlockEngine::OnListSourceLoaded(
-    const DATFileDataBuffer& filters,
+    const DATFileData& filters,
     const std::string& resources_json) {
   auto metadata_and_engine = adblock::engineFromBufferWithMetadata(
-      reinterpret_cast<const char*>(filters.data()), filters.size());
+      reinterpret_cast<const char*>(filters.bytes().data()),
+      filters.bytes().size());
   UpdateAdBlockClient(std::move(metadata_and_engine.second), resources_json);
   return std::move(metadata_and_engine.first);
 }
 
-void AdBlockEngine::OnDATLoaded(const DATFileDataBuffer& dat_buf,
+void AdBlockEngine::OnDATLoaded(const DATFileData& dat_data,
                                 const std::string& resources_json) {
   // An empty buffer will not load successfully.
-  if (dat_buf.empty()) {
+  if (dat_data.empty()) {
     return;
   }
 
   auto client = std::make_unique<adblock::Engine>();
-  client->deserialize(reinterpret_cast<const char*>(&dat_buf.front()),
-                      dat_buf.size());
+  client->deserialize(reinterpret_cast<const char*>(dat_data.bytes().data()),
+                      dat_data.bytes().size());
 
   UpdateAdBlockClient(std::move(client), resources_json);
 }
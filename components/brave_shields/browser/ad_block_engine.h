@@ -14,15 +14,18 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_types.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
 
-using brave_component_updater::DATFileDataBuffer;
+using brave_component_updater::DATFileData;
 
 namespace adblock {
 class Engine;
@@ -37,11 +40,32 @@ class PerfPredictorTabHelperTest;
 namespace brave_shields {
 
 // Service managing an adblock engine.
+//
+// Network request matching may happen on any thread; everything else,
+// including replacing the engine, must happen on the adblock task runner.
 class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
  public:
   using GetDATFileDataResult =
       brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
 
+  // Reference-counted handle on an adblock::Engine. Holding a reference keeps
+  // the engine alive for the duration of a query, even if the owning
+  // AdBlockEngine swaps in a replacement or is destroyed meanwhile.
+  class Client : public base::RefCountedThreadSafe<Client> {
+   public:
+    explicit Client(std::unique_ptr<adblock::Engine> engine);
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    adblock::Engine* engine() const { return engine_.get(); }
+
+   private:
+    friend class base::RefCountedThreadSafe<Client>;
+    ~Client();
+
+    const std::unique_ptr<adblock::Engine> engine_;
+  };
+
   AdBlockEngine();
   AdBlockEngine(const AdBlockEngine&) = delete;
   AdBlockEngine& operator=(const AdBlockEngine&) = delete;
@@ -55,6 +79,20 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Matches |url| against all of |clients| with a single call into the adblock
+  // library. Clients are checked in the order given, so callers must pass them
+  // in the same precedence order as the equivalent sequence of
+  // ShouldStartRequest calls. Can be called from any thread.
+  static void ShouldStartRequestInClients(
+      const std::vector<scoped_refptr<Client>>& clients,
+      const GURL& url,
+      blink::mojom::ResourceType resource_type,
+      const std::string& tab_host,
+      bool aggressive_blocking,
+      bool* did_match_rule,
+      bool* did_match_exception,
+      bool* did_match_important,
+      std::string* mock_data_url);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -63,6 +101,18 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  // Returns the current engine. Can be called from any thread.
+  scoped_refptr<Client> GetClient();
+
+  // Returns a counter that is incremented whenever any engine changes in a
+  // way that can affect network blocking decisions, i.e. when it is replaced
+  // or its resources or tags are modified, or when an engine is added to or
+  // removed from the set consulted for requests. Safe to call from any thread.
+  static uint64_t GetGeneration();
+  // Must be called by the owners of engines after they add, remove, enable or
+  // disable one of them, once the change is visible to request matching.
+  static void IncrementGeneration();
+
   absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
   base::Value::List HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
@@ -71,7 +121,7 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
 
   absl::optional<adblock::FilterListMetadata> Load(
       bool deserialize,
-      const DATFileDataBuffer& dat_buf,
+      const DATFileData& dat_data,
       const std::string& resources_json);
 
   class TestObserver : public base::CheckedObserver {
@@ -87,13 +137,14 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
   void UpdateAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client,
                            const std::string& resources_json);
   adblock::FilterListMetadata OnListSourceLoaded(
-      const DATFileDataBuffer& filters,
+      const DATFileData& filters,
       const std::string& resources_json);
 
-  void OnDATLoaded(const DATFileDataBuffer& dat_buf,
+  void OnDATLoaded(const DATFileData& dat_data,
                    const std::string& resources_json);
 
-  std::unique_ptr<adblock::Engine> ad_block_client_;
+  base::Lock ad_block_client_lock_;
+  scoped_refptr<Client> ad_block_client_ GUARDED_BY(ad_block_client_lock_);
 
  private:
   friend class ::AdBlockServiceTest;
@@ -0,0 +1,159 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/task/thread_pool.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_shields/common/adblock_domain_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+struct ReplayedRequest {
+  const char* url;
+  blink::mojom::ResourceType resource_type;
+  const char* tab_host;
+  bool expect_blocked;
+};
+
+// A small request log in the shape of a page load that issues many parallel
+// subresource requests.
+const ReplayedRequest kRequestLog[] = {
+    {"https://ads.example.com/banner.js", blink::mojom::ResourceType::kScript,
+     "news.com", true},
+    {"https://cdn.example.com/app.js", blink::mojom::ResourceType::kScript,
+     "news.com", false},
+    {"https://tracker.com/pixel.gif", blink::mojom::ResourceType::kImage,
+     "news.com", true},
+    {"https://tracker.com/allowed/pixel.gif",
+     blink::mojom::ResourceType::kImage, "news.com", false},
+    {"https://news.com/style.css", blink::mojom::ResourceType::kStylesheet,
+     "news.com", false},
+    {"https://ads.example.com/frame.html",
+     blink::mojom::ResourceType::kSubFrame, "blog.org", true},
+};
+
+bool ShouldBlock(AdBlockEngine* engine, const ReplayedRequest& request) {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+  engine->ShouldStartRequest(GURL(request.url), request.resource_type,
+                             request.tab_host, false, &did_match_rule,
+                             &did_match_exception, &did_match_important,
+                             &mock_data_url);
+  return did_match_important || (did_match_rule && !did_match_exception);
+}
+
+}  // namespace
+
+class AdBlockEngineTest : public testing::Test {
+ public:
+  AdBlockEngineTest() = default;
+  ~AdBlockEngineTest() override = default;
+
+  void SetUp() override {
+    // Fails harmlessly if another test already set the resolver.
+    adblock::SetDomainResolver(AdBlockServiceDomainResolver);
+    engine_ = std::make_unique<AdBlockEngine>();
+    LoadRules("||ads.example.com^\n||tracker.com^\n@@||tracker.com/allowed/");
+  }
+
+  void LoadRules(const std::string& rules) {
+    engine_->Load(false,
+                  *base::MakeRefCounted<DATFileData>(
+                      brave_component_updater::DATFileDataBuffer(
+                          rules.begin(), rules.end())),
+                  "");
+  }
+
+  // Replays |kRequestLog| |iterations| times on each of |num_threads| thread
+  // pool tasks, and returns whether every result matched expectations.
+  bool ReplayConcurrently(int num_threads, int iterations) {
+    std::atomic<bool> all_matched{true};
+    base::RunLoop run_loop;
+    base::RepeatingClosure barrier =
+        base::BarrierClosure(num_threads, run_loop.QuitClosure());
+    for (int i = 0; i < num_threads; ++i) {
+      base::ThreadPool::PostTaskAndReply(
+          FROM_HERE,
+          base::BindOnce(
+              [](AdBlockEngine* engine, int iterations,
+                 std::atomic<bool>* all_matched) {
+                for (int j = 0; j < iterations; ++j) {
+                  for (const auto& request : kRequestLog) {
+                    if (ShouldBlock(engine, request) !=
+                        request.expect_blocked) {
+                      *all_matched = false;
+                    }
+                  }
+                }
+              },
+              engine_.get(), iterations, &all_matched),
+          barrier);
+    }
+    run_loop.Run();
+    return all_matched;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<AdBlockEngine> engine_;
+};
+
+TEST_F(AdBlockEngineTest, ShouldStartRequest) {
+  for (const auto& request : kRequestLog) {
+    EXPECT_EQ(ShouldBlock(engine_.get(), request), request.expect_blocked)
+        << request.url;
+  }
+}
+
+TEST_F(AdBlockEngineTest, ShouldStartRequestFromMultipleThreads) {
+  EXPECT_TRUE(ReplayConcurrently(1, 100));
+  EXPECT_TRUE(ReplayConcurrently(4, 100));
+  EXPECT_TRUE(ReplayConcurrently(8, 100));
+}
+
+TEST_F(AdBlockEngineTest, ClientOutlivesEngineUpdate) {
+  scoped_refptr<AdBlockEngine::Client> client = engine_->GetClient();
+  LoadRules("||cdn.example.com^");
+  EXPECT_NE(client, engine_->GetClient());
+
+  // The previous engine stays usable by queries that are still holding it.
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  AdBlockEngine::ShouldStartRequestInClients(
+      {client}, GURL("https://ads.example.com/banner.js"),
+      blink::mojom::ResourceType::kScript, "news.com", false, &did_match_rule,
+      &did_match_exception, &did_match_important, nullptr);
+  EXPECT_TRUE(did_match_rule);
+
+  EXPECT_FALSE(ShouldBlock(engine_.get(), kRequestLog[0]));
+  EXPECT_TRUE(ShouldBlock(engine_.get(), kRequestLog[1]));
+}
+
+TEST_F(AdBlockEngineTest, GenerationChangesOnUpdate) {
+  const uint64_t generation = AdBlockEngine::GetGeneration();
+  LoadRules("||cdn.example.com^");
+  EXPECT_GT(AdBlockEngine::GetGeneration(), generation);
+
+  const uint64_t tag_generation = AdBlockEngine::GetGeneration();
+  engine_->EnableTag("brave-test-tag", true);
+  EXPECT_GT(AdBlockEngine::GetGeneration(), tag_generation);
+}
+
+}  // namespace brave_shields
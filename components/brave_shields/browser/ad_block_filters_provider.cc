@@ -24,9 +24,9 @@ void AdBlockFiltersProvider::RemoveObserver(
 }
 
 void AdBlockFiltersProvider::OnDATLoaded(bool deserialize,
-                                         const DATFileDataBuffer& dat_buf) {
+                                         scoped_refptr<DATFileData> dat_data) {
   for (auto& observer : observers_) {
-    observer.OnDATLoaded(deserialize, dat_buf);
+    observer.OnDATLoaded(deserialize, dat_data);
   }
 }
 
@@ -38,9 +38,9 @@ void AdBlockFiltersProvider::LoadDAT(
 
 void AdBlockFiltersProvider::OnLoad(AdBlockFiltersProvider::Observer* observer,
                                     bool deserialize,
-                                    const DATFileDataBuffer& dat_buf) {
+                                    scoped_refptr<DATFileData> dat_data) {
   if (observers_.HasObserver(observer)) {
-    observer->OnDATLoaded(deserialize, dat_buf);
+    observer->OnDATLoaded(deserialize, std::move(dat_data));
   }
 }
 
@@ -12,7 +12,7 @@
 #include "base/observer_list_types.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 
-using brave_component_updater::DATFileDataBuffer;
+using brave_component_updater::DATFileData;
 
 namespace brave_shields {
 
@@ -23,7 +23,7 @@ class AdBlockFiltersProvider {
   class Observer : public base::CheckedObserver {
    public:
     virtual void OnDATLoaded(bool deserialize,
-                             const DATFileDataBuffer& dat_buf) = 0;
+                             scoped_refptr<DATFileData> dat_data) = 0;
   };
 
   AdBlockFiltersProvider();
@@ -41,12 +41,12 @@ class AdBlockFiltersProvider {
  protected:
   virtual void LoadDATBuffer(
       base::OnceCallback<void(bool deserialize,
-                              const DATFileDataBuffer& dat_buf)>) = 0;
+                              scoped_refptr<DATFileData> dat_data)>) = 0;
 
   void OnLoad(AdBlockFiltersProvider::Observer* observer,
               bool deserialize,
-              const DATFileDataBuffer& dat_buf);
-  void OnDATLoaded(bool deserialize, const DATFileDataBuffer& dat_buf);
+              scoped_refptr<DATFileData> dat_data);
+  void OnDATLoaded(bool deserialize, scoped_refptr<DATFileData> dat_data);
 
  private:
   base::ObserverList<Observer> observers_;
@@ -128,6 +128,7 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
         regional_filters_providers_.insert(
             {uuid, std::move(regional_filters_provider)});
         regional_source_observers_.insert({uuid, std::move(observer)});
+        AdBlockEngine::IncrementGeneration();
       }
     }
   }
@@ -182,6 +183,16 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockRegionalServiceManager::AppendClientsForRequest(
+    std::vector<scoped_refptr<AdBlockEngine::Client>>* clients) {
+  DCHECK(clients);
+  base::AutoLock lock(regional_services_lock_);
+
+  for (const auto& regional_service : regional_services_) {
+    clients->push_back(regional_service.second->GetClient());
+  }
+}
+
 absl::optional<std::string> AdBlockRegionalServiceManager::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -281,6 +292,8 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
     std::move(*it2->second).Delete();
     regional_filters_providers_.erase(it2);
   }
+  // Decisions cached for the old set of lists no longer apply.
+  AdBlockEngine::IncrementGeneration();
 
   // Update preferences to reflect enabled/disabled state of specified
   // filter list
@@ -64,6 +64,10 @@ class AdBlockRegionalServiceManager
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Appends the current engines of all enabled regional lists to |clients|,
+  // in the order ShouldStartRequest would check them.
+  void AppendClientsForRequest(
+      std::vector<scoped_refptr<AdBlockEngine::Client>>* clients);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
@@ -17,9 +18,11 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/components/brave_shields/browser/ad_block_component_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_provider.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_default_resource_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_filter_list_catalog_provider.h"
@@ -81,9 +84,9 @@ AdBlockService::SourceProviderObserver::~SourceProviderObserver() {
 
 void AdBlockService::SourceProviderObserver::OnDATLoaded(
     bool deserialize,
-    const DATFileDataBuffer& dat_buf) {
+    scoped_refptr<DATFileData> dat_data) {
   deserialize_ = deserialize;
-  dat_buf_ = std::move(dat_buf);
+  dat_data_ = std::move(dat_data);
   // multiple AddObserver calls are ignored
   resource_provider_->AddObserver(this);
   resource_provider_->LoadResources(base::BindOnce(
@@ -92,23 +95,23 @@ void AdBlockService::SourceProviderObserver::OnDATLoaded(
 
 void AdBlockService::SourceProviderObserver::OnResourcesLoaded(
     const std::string& resources_json) {
-  if (dat_buf_.empty()) {
+  if (!dat_data_ || dat_data_->empty()) {
     task_runner_->PostTask(
         FROM_HERE, base::BindOnce(&AdBlockEngine::AddResources, adblock_engine_,
                                   resources_json));
   } else {
     auto engine_load_callback = base::BindOnce(
         [](base::WeakPtr<AdBlockEngine> engine, bool deserialize,
-           DATFileDataBuffer dat_buf, const std::string& resources_json)
+           scoped_refptr<DATFileData> dat_data,
+           const std::string& resources_json)
             -> absl::optional<adblock::FilterListMetadata> {
           if (engine) {
-            return engine->Load(deserialize, std::move(dat_buf),
-                                resources_json);
+            return engine->Load(deserialize, *dat_data, resources_json);
           } else {
             return absl::nullopt;
           }
         },
-        adblock_engine_, deserialize_, std::move(dat_buf_), resources_json);
+        adblock_engine_, deserialize_, std::move(dat_data_), resources_json);
     task_runner_->PostTaskAndReplyWithResult(
         FROM_HERE, std::move(engine_load_callback),
         base::BindOnce(&SourceProviderObserver::OnEngineReplaced,
@@ -134,38 +137,28 @@ void AdBlockService::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // Engines are only swapped and destroyed on the adblock task runner, so the
+  // current client of every enabled engine is collected in precedence order
+  // and all of them are checked in a single pass, from whichever thread this
+  // is called on.
+  DCHECK(default_service_ && custom_filters_service_ &&
+         regional_service_manager_);
+  std::vector<scoped_refptr<AdBlockEngine::Client>> clients;
   if (aggressive_blocking ||
       base::FeatureList::IsEnabled(
           brave_shields::features::kBraveAdblockDefault1pBlocking) ||
       !SameDomainOrHost(
           url, url::Origin::CreateFromNormalizedTuple("https", tab_host, 80),
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
-    default_service()->ShouldStartRequest(
-        url, resource_type, tab_host, aggressive_blocking, did_match_rule,
-        did_match_exception, did_match_important, mock_data_url);
-    if (did_match_important && *did_match_important) {
-      return;
-    }
-  }
-
-  regional_service_manager()->ShouldStartRequest(
-      url, resource_type, tab_host, aggressive_blocking, did_match_rule,
-      did_match_exception, did_match_important, mock_data_url);
-  if (did_match_important && *did_match_important) {
-    return;
-  }
-
-  subscription_service_manager()->ShouldStartRequest(
-      url, resource_type, tab_host, aggressive_blocking, did_match_rule,
-      did_match_exception, did_match_important, mock_data_url);
-  if (did_match_important && *did_match_important) {
-    return;
+    clients.push_back(default_service_->GetClient());
   }
+  regional_service_manager_->AppendClientsForRequest(&clients);
+  subscription_service_manager_->AppendClientsForRequest(&clients);
+  clients.push_back(custom_filters_service_->GetClient());
 
-  custom_filters_service()->ShouldStartRequest(
-      url, resource_type, tab_host, aggressive_blocking, did_match_rule,
-      did_match_exception, did_match_important, mock_data_url);
+  AdBlockEngine::ShouldStartRequestInClients(
+      clients, url, resource_type, tab_host, aggressive_blocking,
+      did_match_rule, did_match_exception, did_match_important, mock_data_url);
 }
 
 absl::optional<std::string> AdBlockService::GetCspDirectives(
@@ -311,6 +304,10 @@ AdBlockService::custom_filters_provider() {
   return custom_filters_provider_.get();
 }
 
+AdBlockDecisionCache* AdBlockService::decision_cache() {
+  return decision_cache_.get();
+}
+
 brave_shields::AdBlockSubscriptionServiceManager*
 AdBlockService::subscription_service_manager() {
   if (!subscription_service_manager_->IsInitialized()) {
@@ -330,9 +327,13 @@ AdBlockService::AdBlockService(
       locale_(locale),
       component_update_service_(cus),
       task_runner_(task_runner),
+      request_matching_task_runner_(base::ThreadPool::CreateTaskRunner(
+          {base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
       custom_filters_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
       default_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
-      subscription_service_manager_(std::move(subscription_service_manager)) {
+      subscription_service_manager_(std::move(subscription_service_manager)),
+      decision_cache_(std::make_unique<AdBlockDecisionCache>()) {
   // Initializes adblock-rust's domain resolution implementation
   adblock::SetDomainResolver(AdBlockServiceDomainResolver);
 
@@ -377,6 +378,10 @@ base::SequencedTaskRunner* AdBlockService::GetTaskRunner() {
   return task_runner_.get();
 }
 
+base::TaskRunner* AdBlockService::GetRequestMatchingTaskRunner() {
+  return request_matching_task_runner_.get();
+}
+
 void RegisterPrefsForAdBlockService(PrefRegistrySimple* registry) {
   registry->RegisterBooleanPref(prefs::kAdBlockCookieListOptInShown, false);
   registry->RegisterBooleanPref(prefs::kAdBlockCookieListSettingTouched, false);
@@ -16,6 +16,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/task_runner.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_resource_provider.h"
@@ -46,6 +47,7 @@ namespace brave_shields {
 
 class AdBlockEngine;
 class AdBlockComponentFiltersProvider;
+class AdBlockDecisionCache;
 class AdBlockDefaultResourceProvider;
 class AdBlockRegionalServiceManager;
 class AdBlockCustomFiltersProvider;
@@ -72,7 +74,7 @@ class AdBlockService {
    private:
     // AdBlockFiltersProvider::Observer
     void OnDATLoaded(bool deserialize,
-                     const DATFileDataBuffer& dat_buf) override;
+                     scoped_refptr<DATFileData> dat_data) override;
 
     // AdBlockResourceProvider::Observer
     void OnResourcesLoaded(const std::string& resources_json) override;
@@ -81,7 +83,8 @@ class AdBlockService {
         const absl::optional<adblock::FilterListMetadata> maybe_metadata);
 
     bool deserialize_;
-    DATFileDataBuffer dat_buf_;
+    // Only held until the engine has been built from it.
+    scoped_refptr<DATFileData> dat_data_;
     base::WeakPtr<AdBlockEngine> adblock_engine_;
     raw_ptr<AdBlockFiltersProvider> filters_provider_;    // not owned
     raw_ptr<AdBlockResourceProvider> resource_provider_;  // not owned
@@ -102,6 +105,8 @@ class AdBlockService {
   AdBlockService& operator=(const AdBlockService&) = delete;
   ~AdBlockService();
 
+  // Unlike the other query methods, this can be called from any thread once
+  // the service has been started, see GetRequestMatchingTaskRunner.
   void ShouldStartRequest(const GURL& url,
                           blink::mojom::ResourceType resource_type,
                           const std::string& tab_host,
@@ -127,9 +132,16 @@ class AdBlockService {
 
   AdBlockCustomFiltersProvider* custom_filters_provider();
 
+  // Cache of recent ShouldStartRequest results, usable from any thread.
+  AdBlockDecisionCache* decision_cache();
+
   void EnableTag(const std::string& tag, bool enabled);
 
+  // Sequence on which the engines are loaded and modified.
   base::SequencedTaskRunner* GetTaskRunner();
+  // Unsequenced task runner for ShouldStartRequest, which lets network
+  // requests be matched in parallel.
+  base::TaskRunner* GetRequestMatchingTaskRunner();
 
   bool Start();
 
@@ -157,6 +169,7 @@ class AdBlockService {
   raw_ptr<component_updater::ComponentUpdateService> component_update_service_;
 
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  scoped_refptr<base::TaskRunner> request_matching_task_runner_;
 
   std::unique_ptr<brave_shields::AdBlockDefaultResourceProvider>
       resource_provider_;
@@ -176,6 +189,8 @@ class AdBlockService {
   std::unique_ptr<brave_shields::AdBlockSubscriptionServiceManager>
       subscription_service_manager_;
 
+  std::unique_ptr<AdBlockDecisionCache> decision_cache_;
+
   std::unique_ptr<SourceProviderObserver> default_service_observer_;
   std::unique_ptr<SourceProviderObserver> custom_filters_service_observer_;
 
@@ -25,11 +25,12 @@ AdBlockSubscriptionFiltersProvider::~AdBlockSubscriptionFiltersProvider() =
     default;
 
 void AdBlockSubscriptionFiltersProvider::LoadDATBuffer(
-    base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
+    base::OnceCallback<void(bool deserialize,
+                            scoped_refptr<DATFileData> dat_data)>
         cb) {
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::ReadDATFileData, list_file_),
+      base::BindOnce(&brave_component_updater::MapDATFileData, list_file_),
       base::BindOnce(std::move(cb), false));
 }
 
@@ -257,6 +257,7 @@ void AdBlockSubscriptionServiceManager::CreateSubscription(
     subscription_source_observers_.insert(
         std::make_pair(sub_url, std::move(observer)));
   }
+  AdBlockEngine::IncrementGeneration();
 
   StartDownload(sub_url, true);
 }
@@ -292,6 +293,8 @@ void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
   info->enabled = enabled;
 
   UpdateSubscriptionPrefs(sub_url, *info);
+  // Decisions cached while the list was (not) consulted no longer apply.
+  AdBlockEngine::IncrementGeneration();
 }
 
 void AdBlockSubscriptionServiceManager::DeleteSubscription(
@@ -309,6 +312,7 @@ void AdBlockSubscriptionServiceManager::DeleteSubscription(
     DCHECK(it2 != subscription_filters_providers_.end());
     subscription_filters_providers_.erase(it2);
   }
+  AdBlockEngine::IncrementGeneration();
   ClearSubscriptionPrefs(sub_url);
 
   base::ThreadPool::PostTask(
@@ -528,6 +532,18 @@ void AdBlockSubscriptionServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockSubscriptionServiceManager::AppendClientsForRequest(
+    std::vector<scoped_refptr<AdBlockEngine::Client>>* clients) {
+  DCHECK(clients);
+  base::AutoLock lock(subscription_services_lock_);
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscriptions_, subscription_service.first);
+    if (info && info->enabled) {
+      clients->push_back(subscription_service.second->GetClient());
+    }
+  }
+}
+
 void AdBlockSubscriptionServiceManager::EnableTag(const std::string& tag,
                                                   bool enabled) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -104,6 +104,10 @@ class AdBlockSubscriptionServiceManager {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  // Appends the current engines of all enabled subscriptions to |engines|, in the
+  // order ShouldStartRequest would check them.
+  void AppendClientsForRequest(
+      std::vector<scoped_refptr<AdBlockEngine::Client>>* clients);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
 
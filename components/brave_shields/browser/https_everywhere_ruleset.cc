@@ -0,0 +1,202 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/strings/string_split.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Splits |host| into its labels, dropping a trailing empty label.
+std::vector<base::StringPiece> SplitLabels(base::StringPiece host) {
+  std::vector<base::StringPiece> labels = base::SplitStringPiece(
+      host, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (!labels.empty() && labels.back().empty())
+    labels.pop_back();
+  return labels;
+}
+
+// The rules use $1 style back references, RE2 expects \1.
+std::string CorrectRuleForRE2(const std::string& rule) {
+  std::string corrected(rule);
+  std::replace(corrected.begin(), corrected.end(), '$', '\\');
+  return corrected;
+}
+
+}  // namespace
+
+HTTPSEverywhereRuleset::Pattern::Pattern(const std::string& pattern)
+    : pattern(pattern) {}
+
+HTTPSEverywhereRuleset::Pattern::~Pattern() = default;
+
+const re2::RE2& HTTPSEverywhereRuleset::Pattern::Get() const {
+  if (!re2)
+    re2 = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+  return *re2;
+}
+
+HTTPSEverywhereRuleset::Rule::Rule() = default;
+HTTPSEverywhereRuleset::Rule::Rule(Rule&&) = default;
+HTTPSEverywhereRuleset::Rule::~Rule() = default;
+
+HTTPSEverywhereRuleset::RuleGroup::RuleGroup() = default;
+HTTPSEverywhereRuleset::RuleGroup::RuleGroup(RuleGroup&&) = default;
+HTTPSEverywhereRuleset::RuleGroup::~RuleGroup() = default;
+
+HTTPSEverywhereRuleset::Node::Node() = default;
+HTTPSEverywhereRuleset::Node::~Node() = default;
+
+HTTPSEverywhereRuleset::HTTPSEverywhereRuleset() = default;
+HTTPSEverywhereRuleset::~HTTPSEverywhereRuleset() = default;
+
+bool HTTPSEverywhereRuleset::Add(base::StringPiece key,
+                                 base::StringPiece json) {
+  std::vector<base::StringPiece> labels = SplitLabels(key);
+  bool wildcard = !labels.empty() && labels.back() == "*";
+  if (wildcard)
+    labels.pop_back();
+  if (labels.empty())
+    return false;
+
+  absl::optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return false;
+
+  Ruleset ruleset;
+  for (const auto& top_value : json_object->GetList()) {
+    const base::Value::Dict* top_dict = top_value.GetIfDict();
+    if (!top_dict)
+      continue;
+
+    RuleGroup group;
+    if (const base::Value::List* exclusions = top_dict->FindList("e")) {
+      for (const auto& exclusion : *exclusions) {
+        const base::Value::Dict* exclusion_dict = exclusion.GetIfDict();
+        if (!exclusion_dict)
+          continue;
+        const std::string* pattern = exclusion_dict->FindString("p");
+        if (!pattern)
+          continue;
+        group.exclusions.push_back(
+            std::make_unique<Pattern>(CorrectRuleForRE2(*pattern)));
+      }
+    }
+
+    const base::Value::List* rules = top_dict->FindList("r");
+    if (!rules) {
+      group.rules_missing = true;
+    } else {
+      for (const auto& rule_value : *rules) {
+        const base::Value::Dict* rule_dict = rule_value.GetIfDict();
+        if (!rule_dict)
+          continue;
+        Rule rule;
+        if (rule_dict->Find("d")) {
+          rule.default_rule = true;
+        } else {
+          const std::string* from = rule_dict->FindString("f");
+          const std::string* to = rule_dict->FindString("t");
+          if (!from || !to)
+            continue;
+          rule.from = std::make_unique<Pattern>(*from);
+          rule.to = CorrectRuleForRE2(*to);
+        }
+        group.rules.push_back(std::move(rule));
+      }
+    }
+    ruleset.push_back(std::move(group));
+  }
+
+  Node* node = &root_;
+  for (auto it = labels.begin(); it != labels.end(); ++it) {
+    auto& child = node->children[std::string(*it)];
+    if (!child)
+      child = std::make_unique<Node>();
+    node = child.get();
+  }
+
+  int& index = wildcard ? node->wildcard : node->exact;
+  if (index < 0) {
+    index = rulesets_.size();
+    rulesets_.push_back(std::move(ruleset));
+  } else {
+    rulesets_[index] = std::move(ruleset);
+  }
+  return true;
+}
+
+std::string HTTPSEverywhereRuleset::Apply(const std::string& url,
+                                          base::StringPiece host) const {
+  const std::vector<base::StringPiece> labels = SplitLabels(host);
+  const size_t labels_count = labels.size();
+  // Top level domains are never matched on their own.
+  if (labels_count < 2)
+    return std::string();
+
+  // |path[depth]| is the node for the last |depth| labels of |host|.
+  std::vector<const Node*> path = {&root_};
+  for (auto it = labels.rbegin(); it != labels.rend(); ++it) {
+    auto child = path.back()->children.find(*it);
+    if (child == path.back()->children.end())
+      break;
+    path.push_back(child->second.get());
+  }
+
+  std::vector<int> candidates;
+  if (path.size() == labels_count + 1 && path.back()->exact >= 0)
+    candidates.push_back(path.back()->exact);
+  for (size_t depth = std::min(path.size() - 1, labels_count - 1); depth >= 2;
+       --depth) {
+    if (path[depth]->wildcard >= 0)
+      candidates.push_back(path[depth]->wildcard);
+  }
+
+  for (int index : candidates) {
+    std::string new_url = ApplyRuleset(rulesets_[index], url);
+    if (!new_url.empty())
+      return new_url;
+  }
+  return std::string();
+}
+
+// static
+std::string HTTPSEverywhereRuleset::ApplyRuleset(const Ruleset& ruleset,
+                                                 const std::string& url) {
+  for (const auto& group : ruleset) {
+    for (const auto& exclusion : group.exclusions) {
+      if (re2::RE2::FullMatch(url, exclusion->Get()))
+        return std::string();
+    }
+
+    if (group.rules_missing)
+      return std::string();
+
+    for (const auto& rule : group.rules) {
+      if (rule.default_rule) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, rule.from->Get(), rule.to) &&
+          new_url != url) {
+        return new_url;
+      }
+    }
+  }
+  return std::string();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// In-memory HTTPS Everywhere ruleset. Rulesets are stored in a trie keyed on
+// the reversed host labels, so a lookup walks the host once instead of probing
+// every wildcard expansion separately. The JSON rules are parsed when they are
+// added, and their regular expressions are compiled on first use and kept for
+// subsequent lookups. Not thread safe.
+class HTTPSEverywhereRuleset {
+ public:
+  HTTPSEverywhereRuleset();
+  HTTPSEverywhereRuleset(const HTTPSEverywhereRuleset&) = delete;
+  HTTPSEverywhereRuleset& operator=(const HTTPSEverywhereRuleset&) = delete;
+  ~HTTPSEverywhereRuleset();
+
+  // Adds the rules serialized in |json| under |key|, which uses the database
+  // key format: the reversed host labels (e.g. "com.example.www"), optionally
+  // ending with a "*" label to match any subdomain ("com.example.*"). Returns
+  // false if |key| or |json| is malformed.
+  bool Add(base::StringPiece key, base::StringPiece json);
+
+  // Returns the HTTPS URL for |url|, whose host is |host|, or an empty string
+  // if no rule applies. Rulesets are tried from the most specific match.
+  std::string Apply(const std::string& url, base::StringPiece host) const;
+
+  size_t size() const { return rulesets_.size(); }
+
+ private:
+  struct Pattern {
+    explicit Pattern(const std::string& pattern);
+    ~Pattern();
+
+    const re2::RE2& Get() const;
+
+    std::string pattern;
+    mutable std::unique_ptr<re2::RE2> re2;
+  };
+
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    ~Rule();
+
+    // Set for the "d" rule, which only switches the scheme to https.
+    bool default_rule = false;
+    std::unique_ptr<Pattern> from;
+    std::string to;
+  };
+
+  struct RuleGroup {
+    RuleGroup();
+    RuleGroup(RuleGroup&&);
+    ~RuleGroup();
+
+    std::vector<std::unique_ptr<Pattern>> exclusions;
+    std::vector<Rule> rules;
+    // Mirrors a group without a usable rule list, which stops the lookup for
+    // its ruleset.
+    bool rules_missing = false;
+  };
+
+  using Ruleset = std::vector<RuleGroup>;
+
+  struct Node {
+    Node();
+    ~Node();
+
+    std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+    // Index into |rulesets_| for the host ending at this node, if any.
+    int exact = -1;
+    // Index into |rulesets_| for any subdomain of this node, if any.
+    int wildcard = -1;
+  };
+
+  static std::string ApplyRuleset(const Ruleset& ruleset,
+                                  const std::string& url);
+
+  Node root_;
+  std::vector<Ruleset> rulesets_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
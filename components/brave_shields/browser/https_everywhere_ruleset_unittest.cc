@@ -0,0 +1,103 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(HTTPSEverywhereRulesetTest, DefaultRule) {
+  HTTPSEverywhereRuleset ruleset;
+  ASSERT_TRUE(ruleset.Add("com.digg.www", R"([{"r": [{"d": 1}]}])"));
+  EXPECT_EQ(1u, ruleset.size());
+
+  EXPECT_EQ("https://www.digg.com/",
+            ruleset.Apply("http://www.digg.com/", "www.digg.com"));
+  EXPECT_EQ("", ruleset.Apply("http://digg.com/", "digg.com"));
+  EXPECT_EQ("", ruleset.Apply("http://a.www.digg.com/", "a.www.digg.com"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, RewriteRule) {
+  HTTPSEverywhereRuleset ruleset;
+  ASSERT_TRUE(ruleset.Add(
+      "com.example",
+      R"([{"r": [{"f": "^http://example\\.com/(.*)",
+                  "t": "https://secure.example.com/$1"}]}])"));
+
+  EXPECT_EQ("https://secure.example.com/a/b",
+            ruleset.Apply("http://example.com/a/b", "example.com"));
+  // Applying the same rule again reuses the compiled pattern.
+  EXPECT_EQ("https://secure.example.com/c",
+            ruleset.Apply("http://example.com/c", "example.com"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, Exclusions) {
+  HTTPSEverywhereRuleset ruleset;
+  ASSERT_TRUE(ruleset.Add(
+      "com.example",
+      R"([{"e": [{"p": "^http://example\\.com/insecure/.*"}],
+           "r": [{"d": 1}]}])"));
+
+  EXPECT_EQ("https://example.com/",
+            ruleset.Apply("http://example.com/", "example.com"));
+  EXPECT_EQ("", ruleset.Apply("http://example.com/insecure/page",
+                              "example.com"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, WildcardsFromMostSpecific) {
+  HTTPSEverywhereRuleset ruleset;
+  ASSERT_TRUE(ruleset.Add(
+      "com.example.*",
+      R"([{"r": [{"f": "^http://", "t": "https://wildcard."}]}])"));
+  ASSERT_TRUE(ruleset.Add(
+      "com.example.cdn.*",
+      R"([{"r": [{"f": "^http://", "t": "https://cdn."}]}])"));
+
+  EXPECT_EQ("https://wildcard.www.example.com/",
+            ruleset.Apply("http://www.example.com/", "www.example.com"));
+  EXPECT_EQ("https://wildcard.a.b.example.com/",
+            ruleset.Apply("http://a.b.example.com/", "a.b.example.com"));
+  EXPECT_EQ("https://cdn.img.cdn.example.com/",
+            ruleset.Apply("http://img.cdn.example.com/", "img.cdn.example.com"));
+  // A wildcard doesn't match the bare domain.
+  EXPECT_EQ("", ruleset.Apply("http://example.com/", "example.com"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, FallsBackToLessSpecificRuleset) {
+  HTTPSEverywhereRuleset ruleset;
+  ASSERT_TRUE(ruleset.Add("com.example.*", R"([{"r": [{"d": 1}]}])"));
+  // Doesn't rewrite anything.
+  ASSERT_TRUE(ruleset.Add(
+      "com.example.www",
+      R"([{"r": [{"f": "^http://nomatch/", "t": "https://nomatch/"}]}])"));
+
+  EXPECT_EQ("https://www.example.com/",
+            ruleset.Apply("http://www.example.com/", "www.example.com"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, TopLevelDomainsIgnored) {
+  HTTPSEverywhereRuleset ruleset;
+  ASSERT_TRUE(ruleset.Add("com.*", R"([{"r": [{"d": 1}]}])"));
+  ASSERT_TRUE(ruleset.Add("localhost", R"([{"r": [{"d": 1}]}])"));
+
+  EXPECT_EQ("", ruleset.Apply("http://example.com/", "example.com"));
+  EXPECT_EQ("", ruleset.Apply("http://localhost/", "localhost"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, MalformedInput) {
+  HTTPSEverywhereRuleset ruleset;
+  EXPECT_FALSE(ruleset.Add("", R"([{"r": [{"d": 1}]}])"));
+  EXPECT_FALSE(ruleset.Add("com.example", "{not json"));
+  EXPECT_FALSE(ruleset.Add("com.example", R"({"r": [{"d": 1}]})"));
+  EXPECT_EQ(0u, ruleset.size());
+
+  // Rules with invalid patterns never match.
+  ASSERT_TRUE(ruleset.Add("com.example",
+                          R"([{"r": [{"f": "(", "t": "https://"}]}])"));
+  EXPECT_EQ("", ruleset.Apply("http://example.com/", "example.com"));
+}
+
+}  // namespace brave_shields
@@ -13,16 +13,15 @@
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
-#include "base/strings/utf_string_conversions.h"
-#include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
-#include "third_party/zlib/google/zip.h"
+#include "third_party/leveldatabase/src/include/leveldb/env.h"
+#include "third_party/zlib/google/zip_reader.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
@@ -31,49 +30,68 @@
 
 namespace {
 
-std::vector<std::string> Split(const std::string& s, char delim) {
-  std::stringstream ss(s);
-  std::string item;
-  std::vector<std::string> result;
-  while (getline(ss, item, delim)) {
-    result.push_back(item);
-  }
-  return result;
-}
-
-// returns parts in reverse order, makes list of lookup domains like com.foo.*
-std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
-  std::vector<std::string> resultDomains;
-  std::vector<std::string> domainParts = Split(domain, '.');
-  if (domainParts.empty()) {
-    return resultDomains;
+// Upper bound for a single file of the zipped database.
+constexpr uint64_t kMaxDATEntrySize = 64 * 1024 * 1024;
+
+// Reads the leveldb database zipped at |zip_path| into an in-memory ruleset.
+// The database files are extracted into a memory backed leveldb::Env, so
+// nothing is written to disk.
+std::unique_ptr<brave_shields::HTTPSEverywhereRuleset> LoadRuleset(
+    const base::FilePath& zip_path) {
+  zip::ZipReader reader;
+  if (!reader.Open(zip_path)) {
+    LOG(ERROR) << "Failed to open database file " << zip_path.value().c_str();
+    return nullptr;
   }
 
-  for (size_t i = 0; i < domainParts.size() - 1; i++) {
-    // i < size()-1 is correct: don't want 'com.*' added to resultDomains
-    std::string slice = "";
-    std::string dot = "";
-    for (int j = domainParts.size() - 1; j >= static_cast<int>(i); j--) {
-      slice += dot + domainParts[j];
-      dot = ".";
+  const std::string db_name =
+      zip_path.RemoveExtension().BaseName().AsUTF8Unsafe();
+  std::unique_ptr<leveldb::Env> env = leveldb_env::NewMemEnv("httpse");
+  env->CreateDir(db_name);
+  while (const zip::ZipReader::Entry* entry = reader.Next()) {
+    if (entry->is_directory)
+      continue;
+    std::string contents;
+    if (!reader.ExtractCurrentEntryToString(kMaxDATEntrySize, &contents)) {
+      LOG(ERROR) << "Failed to extract " << entry->path.value().c_str()
+                 << " from database file " << zip_path.value().c_str();
+      return nullptr;
     }
-    if (0 != i) {
-      // We don't want * on the top URL
-      resultDomains.push_back(slice + ".*");
-    } else {
-      resultDomains.push_back(slice);
+    leveldb::Status status = leveldb::WriteStringToFile(
+        env.get(), contents,
+        db_name + "/" + entry->path.BaseName().AsUTF8Unsafe());
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to load database file "
+                 << zip_path.value().c_str() << ", error: "
+                 << status.ToString();
+      return nullptr;
     }
   }
-  return resultDomains;
-}
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
-  if (!db) {
-    return "";
+
+  leveldb::Options options;
+  options.env = env.get();
+  leveldb::DB* db = nullptr;
+  leveldb::Status status = leveldb::DB::Open(options, db_name, &db);
+  std::unique_ptr<leveldb::DB> db_holder(db);
+  if (!status.ok() || !db) {
+    LOG(ERROR) << "Level db open error " << zip_path.value().c_str()
+               << ", error: " << status.ToString();
+    return nullptr;
   }
 
-  std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
-  return s.ok() ? value : "";
+  auto ruleset = std::make_unique<brave_shields::HTTPSEverywhereRuleset>();
+  std::unique_ptr<leveldb::Iterator> it(
+      db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    ruleset->Add(base::StringPiece(it->key().data(), it->key().size()),
+                 base::StringPiece(it->value().data(), it->value().size()));
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Level db read error " << zip_path.value().c_str()
+               << ", error: " << it->status().ToString();
+    return nullptr;
+  }
+  return ruleset;
 }
 
 }  // namespace
@@ -81,45 +99,20 @@ std::string leveldbGet(leveldb::DB* db, const std::string &key) {
 namespace brave_shields {
 
 HTTPSEverywhereService::Engine::Engine(HTTPSEverywhereService* service)
-    : level_db_(nullptr), service_(service) {
+    : service_(service) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
+HTTPSEverywhereService::Engine::~Engine() = default;
+
 void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::FilePath zip_db_file_path =
       base_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
-  base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
-  base::FilePath destination = zip_db_file_path.DirName();
-  // Unzip doesn't allow overwriting existing files, so delete previously
-  // unzipped db. Attempting to delete a non-existent path returns success.
-  bool deleted = base::DeletePathRecursively(unzipped_level_db_path);
-  if (!deleted) {
-    LOG(ERROR) << "Failed to delete unzipped database directory "
-               << unzipped_level_db_path.value().c_str();
-    return;
-  }
+  // Older versions unzipped the database next to the zip file, clean that up.
+  base::DeletePathRecursively(zip_db_file_path.RemoveExtension());
 
-  if (!zip::Unzip(zip_db_file_path, destination)) {
-    LOG(ERROR) << "Failed to unzip database file "
-               << zip_db_file_path.value().c_str();
-    return;
-  }
-
-  CloseDatabase();
-
-  leveldb::Options options;
-  leveldb::Status status =
-      leveldb::DB::Open(options,
-                        unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
-  if (!status.ok() || !level_db_) {
-    LOG(ERROR) << "Level db open error "
-               << unzipped_level_db_path.value().c_str()
-               << ", error: " << status.ToString();
-    CloseDatabase();
-    return;
-  }
+  ruleset_ = LoadRuleset(zip_db_file_path);
 }
 
 bool HTTPSEverywhereService::Engine::GetHTTPSURL(
@@ -131,7 +124,7 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   if (!url->is_valid())
     return false;
 
-  if (!level_db_ || url->scheme() == url::kHttpsScheme) {
+  if (!ruleset_ || url->scheme() == url::kHttpsScheme) {
     return false;
   }
 
@@ -152,127 +145,16 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   }
 
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.GetHTTPSURL");
-  const std::vector<std::string> domains =
-      ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        service_->recently_used_cache().add(candidate_url.spec(), *new_url);
-        service_->AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
-    }
+  *new_url = ruleset_->Apply(candidate_url.spec(), candidate_url.host_piece());
+  if (!new_url->empty()) {
+    service_->recently_used_cache().add(candidate_url.spec(), *new_url);
+    service_->AddHTTPSEUrlToRedirectList(request_identifier);
+    return true;
   }
   service_->recently_used_cache().remove(candidate_url.spec());
   return false;
 }
 
-std::string HTTPSEverywhereService::Engine::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (absl::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  const base::Value::List& topValues = json_object->GetList();
-  for (const auto& topValue : topValues) {
-    if (!topValue.is_dict()) {
-      continue;
-    }
-    const base::Value::Dict* childTopDictionary = topValue.GetIfDict();
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = childTopDictionary->Find("e");
-    if (nullptr != exclusion) {
-      const base::Value::List* eValues = exclusion->GetIfList();
-      if (nullptr != eValues) {
-        for (const auto& eValue : *eValues) {
-          const base::Value::Dict* pDictionary = eValue.GetIfDict();
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = pDictionary->Find("p");
-          if (!patternValue) {
-            continue;
-          }
-          if (!patternValue->is_string()) {
-            continue;
-          }
-          std::string pattern =
-              CorrecttoRuleToRE2Engine(patternValue->GetString());
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = childTopDictionary->Find("r");
-    if (!rules) {
-      return "";
-    }
-    const base::Value::List* rValues = rules->GetIfList();
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (const auto& rValue : *rValues) {
-      const base::Value::Dict* pDictionary = rValue.GetIfDict();
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = pDictionary->Find("d");
-      if (patternValue) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = pDictionary->Find("f");
-      const base::Value* to_value = pDictionary->Find("t");
-      if (!from_value || !to_value) {
-        continue;
-      }
-      if (!from_value->is_string() || !to_value->is_string()) {
-        continue;
-      }
-
-      std::string to = CorrecttoRuleToRE2Engine(to_value->GetString());
-      std::string newUrl(originalUrl);
-      RE2 regExp(from_value->GetString());
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::Engine::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
-
-void HTTPSEverywhereService::Engine::CloseDatabase() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
-  }
-}
-
 bool HTTPSEverywhereService::g_ignore_port_for_test_(false);
 
 HTTPSEverywhereService::HTTPSEverywhereService(
@@ -17,16 +17,14 @@
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 
-namespace leveldb {
-class DB;
-}
-
 class HTTPSEverywhereServiceTest;
 
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSEverywhereRuleset;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
@@ -56,6 +54,7 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
     explicit Engine(HTTPSEverywhereService* service);
     Engine(const Engine&) = delete;
     Engine& operator=(const Engine&) = delete;
+    ~Engine();
 
     void Init(const base::FilePath& base_dir);
     bool GetHTTPSURL(const GURL* url,
@@ -63,12 +62,7 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
                      std::string* new_url);
 
    private:
-    std::string ApplyHTTPSRule(const std::string& originalUrl,
-                               const std::string& rule);
-    std::string CorrecttoRuleToRE2Engine(const std::string& to);
-    void CloseDatabase();
-
-    leveldb::DB* level_db_;
+    std::unique_ptr<HTTPSEverywhereRuleset> ruleset_;
     HTTPSEverywhereService* service_;  // not owned
     SEQUENCE_CHECKER(sequence_checker_);
   };
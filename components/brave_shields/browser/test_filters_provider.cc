@@ -19,21 +19,24 @@ TestFiltersProvider::TestFiltersProvider(const base::FilePath& dat_location,
     : resources_(resources) {
   CHECK(!dat_location.empty());
 
-  dat_buffer_ = brave_component_updater::ReadDATFileData(dat_location);
+  dat_data_ = base::MakeRefCounted<DATFileData>(
+      brave_component_updater::ReadDATFileData(dat_location));
 
-  CHECK(!dat_buffer_.empty());
+  CHECK(!dat_data_->empty());
 }
 
 TestFiltersProvider::~TestFiltersProvider() = default;
 
 void TestFiltersProvider::LoadDATBuffer(
-    base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
+    base::OnceCallback<void(bool deserialize,
+                            scoped_refptr<DATFileData> dat_data)>
         cb) {
-  if (dat_buffer_.empty()) {
+  if (!dat_data_) {
     auto buffer = std::vector<unsigned char>(rules_.begin(), rules_.end());
-    std::move(cb).Run(false, buffer);
+    std::move(cb).Run(false,
+                      base::MakeRefCounted<DATFileData>(std::move(buffer)));
   } else {
-    std::move(cb).Run(true, dat_buffer_);
+    std::move(cb).Run(true, dat_data_);
   }
 }
 
@@ -15,7 +15,7 @@
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_resource_provider.h"
 
-using brave_component_updater::DATFileDataBuffer;
+using brave_component_updater::DATFileData;
 
 namespace brave_shields {
 
@@ -29,13 +29,14 @@ class TestFiltersProvider : public AdBlockFiltersProvider,
 
   void LoadDATBuffer(
       base::OnceCallback<void(bool deserialize,
-                              const DATFileDataBuffer& dat_buf)> cb) override;
+                              scoped_refptr<DATFileData> dat_data)> cb)
+      override;
 
   void LoadResources(
       base::OnceCallback<void(const std::string& resources_json)> cb) override;
 
  private:
-  DATFileDataBuffer dat_buffer_;
+  scoped_refptr<DATFileData> dat_data_;
   std::string rules_;
   std::string resources_;
 };
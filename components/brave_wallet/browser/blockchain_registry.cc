@@ -5,9 +5,10 @@
 
 #include "brave/components/brave_wallet/browser/blockchain_registry.h"
 
+#include <algorithm>
 #include <utility>
 
-#include "base/ranges/algorithm.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
@@ -18,6 +19,12 @@ namespace brave_wallet {
 BlockchainRegistry::BlockchainRegistry() = default;
 BlockchainRegistry::~BlockchainRegistry() = default;
 
+BlockchainRegistry::TokenListIndex::TokenListIndex() = default;
+BlockchainRegistry::TokenListIndex::TokenListIndex(TokenListIndex&&) = default;
+BlockchainRegistry::TokenListIndex&
+BlockchainRegistry::TokenListIndex::operator=(TokenListIndex&&) = default;
+BlockchainRegistry::TokenListIndex::~TokenListIndex() = default;
+
 BlockchainRegistry* BlockchainRegistry::GetInstance() {
   return base::Singleton<BlockchainRegistry>::get();
 }
@@ -36,12 +43,72 @@ void BlockchainRegistry::Bind(
 
 void BlockchainRegistry::UpdateTokenList(TokenListMap token_list_map) {
   token_list_map_ = std::move(token_list_map);
+  token_list_indexes_.clear();
+  for (const auto& token_list : token_list_map_)
+    IndexTokenList(token_list.first);
 }
 
 void BlockchainRegistry::UpdateTokenList(
     const std::string key,
     std::vector<mojom::BlockchainTokenPtr> list) {
   token_list_map_[key] = std::move(list);
+  IndexTokenList(key);
+}
+
+void BlockchainRegistry::IndexTokenList(const std::string& key) {
+  TokenListIndex index;
+  const auto& tokens = token_list_map_[key];
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const auto& token = tokens[i];
+    // The first token wins on duplicates, like a front to back search would.
+    index.by_address.emplace(token->coin == mojom::CoinType::ETH
+                                 ? base::ToLowerASCII(token->contract_address)
+                                 : token->contract_address,
+                             i);
+    index.by_symbol.emplace(token->symbol, i);
+  }
+  token_list_indexes_[key] = std::move(index);
+}
+
+const mojom::BlockchainTokenPtr* BlockchainRegistry::FindTokenByAddress(
+    const std::string& chain_id,
+    mojom::CoinType coin,
+    const std::string& address) const {
+  const auto key = GetTokenListKey(coin, chain_id);
+  auto index_it = token_list_indexes_.find(key);
+  if (index_it == token_list_indexes_.end())
+    return nullptr;
+
+  const auto& by_address = index_it->second.by_address;
+  auto it = by_address.find(coin == mojom::CoinType::ETH
+                                ? base::ToLowerASCII(address)
+                                : address);
+  if (it == by_address.end())
+    return nullptr;
+  return &token_list_map_.at(key)[it->second];
+}
+
+const mojom::BlockchainTokenPtr* BlockchainRegistry::FindTokenBySymbol(
+    const std::string& chain_id,
+    mojom::CoinType coin,
+    const std::string& symbol) const {
+  const auto key = GetTokenListKey(coin, chain_id);
+  auto index_it = token_list_indexes_.find(key);
+  if (index_it == token_list_indexes_.end())
+    return nullptr;
+
+  const auto& by_symbol = index_it->second.by_symbol;
+  auto it = by_symbol.find(symbol);
+  if (it == by_symbol.end())
+    return nullptr;
+  return &token_list_map_.at(key)[it->second];
+}
+
+const std::vector<mojom::BlockchainTokenPtr>* BlockchainRegistry::GetTokenList(
+    const std::string& chain_id,
+    mojom::CoinType coin) const {
+  auto it = token_list_map_.find(GetTokenListKey(coin, chain_id));
+  return it == token_list_map_.end() ? nullptr : &it->second;
 }
 
 void BlockchainRegistry::UpdateChainList(ChainList chains) {
@@ -59,51 +126,35 @@ mojom::BlockchainTokenPtr BlockchainRegistry::GetTokenByAddress(
     const std::string& chain_id,
     mojom::CoinType coin,
     const std::string& address) {
-  const auto key = GetTokenListKey(coin, chain_id);
-  if (!token_list_map_.contains(key))
-    return nullptr;
+  const auto* token = FindTokenByAddress(chain_id, coin, address);
+  return token ? token->Clone() : nullptr;
+}
 
-  const auto& tokens = token_list_map_[key];
-  auto token_it = base::ranges::find_if(
-      tokens, [&](const mojom::BlockchainTokenPtr& current_token) {
-        return current_token->contract_address == address;
-      });
-  return token_it == tokens.end() ? nullptr : token_it->Clone();
+mojom::BlockchainTokenPtr BlockchainRegistry::GetTokenBySymbol(
+    const std::string& chain_id,
+    mojom::CoinType coin,
+    const std::string& symbol) {
+  const auto* token = FindTokenBySymbol(chain_id, coin, symbol);
+  return token ? token->Clone() : nullptr;
 }
 
 void BlockchainRegistry::GetTokenBySymbol(const std::string& chain_id,
                                           mojom::CoinType coin,
                                           const std::string& symbol,
                                           GetTokenBySymbolCallback callback) {
-  const auto key = GetTokenListKey(coin, chain_id);
-  if (!token_list_map_.contains(key)) {
-    std::move(callback).Run(nullptr);
-    return;
-  }
-  const auto& tokens = token_list_map_[key];
-  auto token_it = base::ranges::find_if(
-      tokens, [&](const mojom::BlockchainTokenPtr& current_token) {
-        return current_token->symbol == symbol;
-      });
-
-  if (token_it == tokens.end()) {
-    std::move(callback).Run(nullptr);
-    return;
-  }
-
-  std::move(callback).Run(token_it->Clone());
+  std::move(callback).Run(GetTokenBySymbol(chain_id, coin, symbol));
 }
 
 void BlockchainRegistry::GetAllTokens(const std::string& chain_id,
                                       mojom::CoinType coin,
                                       GetAllTokensCallback callback) {
-  const auto key = GetTokenListKey(coin, chain_id);
-  if (!token_list_map_.contains(key)) {
+  const auto* tokens_ptr = GetTokenList(chain_id, coin);
+  if (!tokens_ptr) {
     std::move(callback).Run(
         std::vector<brave_wallet::mojom::BlockchainTokenPtr>());
     return;
   }
-  const auto& tokens = token_list_map_[key];
+  const auto& tokens = *tokens_ptr;
   std::vector<brave_wallet::mojom::BlockchainTokenPtr> tokens_copy(
       tokens.size());
   std::transform(
@@ -7,8 +7,10 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_BLOCKCHAIN_REGISTRY_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/singleton.h"
 #include "brave/components/brave_wallet/browser/blockchain_list_parser.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
@@ -37,6 +39,15 @@ class BlockchainRegistry : public mojom::BlockchainRegistry {
   mojom::BlockchainTokenPtr GetTokenByAddress(const std::string& chain_id,
                                               mojom::CoinType coin,
                                               const std::string& address);
+  mojom::BlockchainTokenPtr GetTokenBySymbol(const std::string& chain_id,
+                                             mojom::CoinType coin,
+                                             const std::string& symbol);
+  // Returns the token list of |chain_id| without copying it, or nullptr if
+  // there is none. The list is owned by the registry and replaced by the next
+  // UpdateTokenList call, so it must not be held on to.
+  const std::vector<mojom::BlockchainTokenPtr>* GetTokenList(
+      const std::string& chain_id,
+      mojom::CoinType coin) const;
   std::vector<mojom::NetworkInfoPtr> GetPrepopulatedNetworks();
 
   // BlockchainRegistry interface methods
@@ -68,7 +79,32 @@ class BlockchainRegistry : public mojom::BlockchainRegistry {
   std::vector<mojom::BlockchainTokenPtr>* GetTokenListFromChainId(
       const std::string& chain_id);
 
+  // Positions of the tokens of a token list, by contract address and symbol.
+  // EVM contract addresses are lowercase so that they match regardless of
+  // their checksum casing.
+  struct TokenListIndex {
+    TokenListIndex();
+    TokenListIndex(TokenListIndex&&);
+    TokenListIndex& operator=(TokenListIndex&&);
+    ~TokenListIndex();
+
+    std::unordered_map<std::string, size_t> by_address;
+    std::unordered_map<std::string, size_t> by_symbol;
+  };
+
+  void IndexTokenList(const std::string& key);
+  const mojom::BlockchainTokenPtr* FindTokenByAddress(
+      const std::string& chain_id,
+      mojom::CoinType coin,
+      const std::string& address) const;
+  const mojom::BlockchainTokenPtr* FindTokenBySymbol(
+      const std::string& chain_id,
+      mojom::CoinType coin,
+      const std::string& symbol) const;
+
   TokenListMap token_list_map_;
+  // <token list key, index of token_list_map_[key]>
+  base::flat_map<std::string, TokenListIndex> token_list_indexes_;
   ChainList chain_list_;
   friend struct base::DefaultSingletonTraits<BlockchainRegistry>;
 
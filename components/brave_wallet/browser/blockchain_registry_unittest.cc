@@ -401,6 +401,50 @@ TEST(BlockchainRegistryUnitTest, GetTokenBySymbol) {
   run_loop5.Run();
 }
 
+TEST(BlockchainRegistryUnitTest, IndexedTokenLookups) {
+  base::test::TaskEnvironment task_environment;
+  auto* registry = BlockchainRegistry::GetInstance();
+  TokenListMap token_list_map;
+  ASSERT_TRUE(
+      ParseTokenList(token_list_json, &token_list_map, mojom::CoinType::ETH));
+  ASSERT_TRUE(ParseTokenList(solana_token_list_json, &token_list_map,
+                             mojom::CoinType::SOL));
+  registry->UpdateTokenList(std::move(token_list_map));
+
+  // EVM addresses are matched regardless of checksum casing
+  auto token = registry->GetTokenByAddress(
+      mojom::kMainnetChainId, mojom::CoinType::ETH,
+      "0x0d8775f648430679a709e98d2b0cb6250d2887ef");
+  ASSERT_TRUE(token);
+  EXPECT_EQ(token->symbol, "BAT");
+  EXPECT_EQ(token->contract_address,
+            "0x0D8775F648430679A709E98d2b0Cb6250d2887EF");
+
+  // Solana addresses are case sensitive
+  EXPECT_EQ(registry->GetTokenByAddress(
+                mojom::kSolanaMainnet, mojom::CoinType::SOL,
+                "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v"),
+            usdc);
+  EXPECT_FALSE(registry->GetTokenByAddress(
+      mojom::kSolanaMainnet, mojom::CoinType::SOL,
+      "epjfwdd5aufqssqem2qn1xzybapc8g4weggkzwytdt1v"));
+
+  token = registry->GetTokenBySymbol(mojom::kMainnetChainId,
+                                     mojom::CoinType::ETH, "CK");
+  ASSERT_TRUE(token);
+  EXPECT_EQ(token->name, "Crypto Kitties");
+
+  // The list is exposed without copying it
+  const auto* token_list =
+      registry->GetTokenList(mojom::kMainnetChainId, mojom::CoinType::ETH);
+  ASSERT_TRUE(token_list);
+  EXPECT_EQ(token_list->size(), 2UL);
+  EXPECT_EQ(token_list, registry->GetTokenList(mojom::kMainnetChainId,
+                                               mojom::CoinType::ETH));
+  EXPECT_FALSE(
+      registry->GetTokenList(mojom::kRinkebyChainId, mojom::CoinType::ETH));
+}
+
 TEST(BlockchainRegistryUnitTest, GetBuyTokens) {
   base::test::TaskEnvironment task_environment;
   auto* registry = BlockchainRegistry::GetInstance();
@@ -1176,18 +1176,6 @@ void BraveWalletService::AddSuggestTokenRequest(
   DCHECK(!request->token->contract_address.empty());
   DCHECK(request->token->is_erc20 && !request->token->is_erc721);
 
-  if (add_suggest_token_requests_.contains(request->token->contract_address)) {
-    bool reject = true;
-    base::Value formed_response = GetProviderErrorDictionary(
-        mojom::ProviderError::kInvalidParams,
-        l10n_util::GetStringUTF8(IDS_WALLET_ALREADY_IN_PROGRESS_ERROR));
-    std::move(callback).Run(std::move(id), std::move(formed_response), reject,
-                            "", false);
-    return;
-  }
-
-  const std::string addr = request->token->contract_address;
-
   // Priority of token source:
   //     1. User asset list
   //     2. BlockchainRegistry
@@ -1199,11 +1187,27 @@ void BraveWalletService::AddSuggestTokenRequest(
 
   if (!token)
     token = BlockchainRegistry::GetInstance()->GetTokenByAddress(
-        request->token->chain_id, request->token->coin, addr);
+        request->token->chain_id, request->token->coin,
+        request->token->contract_address);
 
   if (token)
     request->token = std::move(token);
 
+  // Pending requests are keyed by the address of the stored token, which is
+  // the one NotifyAddSuggestTokenRequestsProcessed is called with. It can
+  // differ in case from the requested address when the token comes from
+  // BlockchainRegistry.
+  const std::string addr = request->token->contract_address;
+  if (add_suggest_token_requests_.contains(addr)) {
+    bool reject = true;
+    base::Value formed_response = GetProviderErrorDictionary(
+        mojom::ProviderError::kInvalidParams,
+        l10n_util::GetStringUTF8(IDS_WALLET_ALREADY_IN_PROGRESS_ERROR));
+    std::move(callback).Run(std::move(id), std::move(formed_response), reject,
+                            "", false);
+    return;
+  }
+
   add_suggest_token_requests_[addr] = std::move(request);
   add_suggest_token_callbacks_[addr] = std::move(callback);
   add_suggest_token_ids_[addr] = std::move(id);
@@ -15,6 +15,7 @@
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/tx_meta.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "brave/components/brave_wallet/common/hex_utils.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
@@ -117,16 +118,10 @@ void EthPendingTxTracker::OnSendRawTransaction(
     const std::string& error_message) {}
 
 bool EthPendingTxTracker::IsNonceTaken(const EthTxMeta& meta) {
-  auto confirmed_transactions = tx_state_manager_->GetTransactionsByStatus(
-      mojom::TransactionStatus::Confirmed, absl::nullopt);
-  for (const auto& confirmed_transaction : confirmed_transactions) {
-    auto* eth_confirmed_transaction =
-        static_cast<EthTxMeta*>(confirmed_transaction.get());
-    if (eth_confirmed_transaction->tx()->nonce() == meta.tx()->nonce() &&
-        eth_confirmed_transaction->id() != meta.id())
-      return true;
-  }
-  return false;
+  const auto& nonce = meta.tx()->nonce();
+  return tx_state_manager_->HasTxWithNonce(
+      mojom::TransactionStatus::Confirmed, meta.from(),
+      nonce ? Uint256ValueToHex(*nonce) : "", meta.id());
 }
 
 bool EthPendingTxTracker::ShouldTxDropped(const EthTxMeta& meta) {
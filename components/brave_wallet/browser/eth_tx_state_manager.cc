@@ -104,6 +104,14 @@ std::unique_ptr<TxMeta> EthTxStateManager::ValueToTxMeta(
   return meta;
 }
 
+absl::optional<std::string> EthTxStateManager::GetTxNonce(
+    const base::Value::Dict& value) {
+  const std::string* nonce = value.FindStringByDottedPath("tx.nonce");
+  if (!nonce)
+    return absl::nullopt;
+  return *nonce;
+}
+
 std::string EthTxStateManager::GetTxPrefPathPrefix() {
   return base::StrCat(
       {kEthereumPrefKey, ".",
@@ -50,6 +50,8 @@ class EthTxStateManager : public TxStateManager {
   std::unique_ptr<TxMeta> ValueToTxMeta(
       const base::Value::Dict& value) override;
   std::string GetTxPrefPathPrefix() override;
+  absl::optional<std::string> GetTxNonce(
+      const base::Value::Dict& value) override;
 };
 
 }  // namespace brave_wallet
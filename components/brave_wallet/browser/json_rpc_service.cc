@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <unordered_set>
 #include <utility>
@@ -12,11 +14,14 @@
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/feature_list.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
 #include "base/notreached.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/blockchain_registry.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
@@ -76,6 +81,17 @@ constexpr char kDomainPattern[] =
 constexpr char kUDPattern[] =
     "(?:[a-z0-9-]+)\\.(?:crypto|x|coin|nft|dao|wallet|blockchain|bitcoin|zil)";
 
+// Upper bound on the number of calls packed into a single JSON-RPC batch, some
+// providers reject larger batches.
+constexpr size_t kMaxJsonRpcBatchSize = 20;
+
+// Lifetimes of cached responses, see JsonRpcService::ResponseCacheScope.
+constexpr base::TimeDelta kShortLivedResponseCacheTtl = base::Seconds(2);
+constexpr base::TimeDelta kBlockResponseCacheTtl = base::Seconds(15);
+constexpr base::TimeDelta kImmutableResponseCacheTtl = base::Hours(24);
+// Upper bound on the number of responses cached per network.
+constexpr size_t kMaxCachedResponsesPerNetwork = 500;
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("json_rpc_service", R"(
       semantics {
@@ -142,6 +158,18 @@ void SetEnsOffchainPref(PrefService* local_state_prefs, bool enabled) {
                                  : EnsOffchainResolveMethod::kDisabled);
 }
 
+// Only successful results are cached, errors are always fetched again.
+bool IsCacheableResponse(
+    const api_request_helper::APIRequestResult& api_request_result) {
+  if (!api_request_result.Is2XXResponseCode())
+    return false;
+  auto response = base::JSONReader::Read(api_request_result.body());
+  if (!response || !response->is_dict())
+    return false;
+  const auto* result = response->GetDict().Find("result");
+  return result && !result->is_none() && !response->GetDict().Find("error");
+}
+
 namespace solana {
 // https://github.com/solana-labs/solana/blob/f7b2951c79cd07685ed62717e78ab1c200924924/rpc/src/rpc.rs#L1717
 constexpr char kAccountNotCreatedError[] = "could not find account";
@@ -260,15 +288,305 @@ void JsonRpcService::RequestInternal(
                                std::move(conversion_callback));
 }
 
+JsonRpcService::BatchedRequest::BatchedRequest(
+    std::string json_payload,
+    RequestIntermediateCallback callback)
+    : json_payload(std::move(json_payload)), callback(std::move(callback)) {}
+JsonRpcService::BatchedRequest::BatchedRequest(BatchedRequest&&) = default;
+JsonRpcService::BatchedRequest& JsonRpcService::BatchedRequest::operator=(
+    BatchedRequest&&) = default;
+JsonRpcService::BatchedRequest::~BatchedRequest() = default;
+
+void JsonRpcService::RequestBatched(const std::string& json_payload,
+                                    const GURL& network_url,
+                                    const std::string& uint64_result_path,
+                                    RequestIntermediateCallback callback) {
+  DCHECK(network_url.is_valid());
+
+  BatchKey key(network_url, uint64_result_path);
+  if (batch_unsupported_urls_.contains(network_url)) {
+    SendUnbatched(key, BatchedRequest(json_payload, std::move(callback)));
+    return;
+  }
+  auto& requests = batched_requests_[key];
+  if (requests.empty()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&JsonRpcService::FlushBatchedRequests,
+                                  weak_ptr_factory_.GetWeakPtr(), key));
+  }
+  requests.emplace_back(json_payload, std::move(callback));
+}
+
+void JsonRpcService::FlushBatchedRequests(const BatchKey& key) {
+  auto it = batched_requests_.find(key);
+  if (it == batched_requests_.end())
+    return;
+  std::vector<BatchedRequest> requests = std::move(it->second);
+  batched_requests_.erase(it);
+
+  for (size_t begin = 0; begin < requests.size();
+       begin += kMaxJsonRpcBatchSize) {
+    const size_t end = std::min(requests.size(), begin + kMaxJsonRpcBatchSize);
+    SendBatch(key, std::vector<BatchedRequest>(
+                       std::make_move_iterator(requests.begin() + begin),
+                       std::make_move_iterator(requests.begin() + end)));
+  }
+}
+
+void JsonRpcService::SendBatch(const BatchKey& key,
+                               std::vector<BatchedRequest> requests) {
+  if (requests.size() == 1) {
+    SendUnbatched(key, std::move(requests.front()));
+    return;
+  }
+
+  // Calls are renumbered by their position in the batch so that responses,
+  // which may come back in any order, can be matched to their callbacks.
+  std::vector<BatchedRequest> batch;
+  base::Value::List payload;
+  for (auto& request : requests) {
+    auto value = base::JSONReader::Read(request.json_payload);
+    if (!value || !value->is_dict()) {
+      SendUnbatched(key, std::move(request));
+      continue;
+    }
+    if (auto* id = value->GetDict().Find("id"))
+      request.id = id->Clone();
+    value->GetDict().Set("id", static_cast<int>(batch.size()));
+    payload.Append(std::move(*value));
+    batch.push_back(std::move(request));
+  }
+  if (batch.empty())
+    return;
+  if (batch.size() == 1) {
+    SendUnbatched(key, std::move(batch.front()));
+    return;
+  }
+
+  APIRequestHelper::ResponseConversionCallback conversion_callback;
+  if (!key.second.empty()) {
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < batch.size(); ++i)
+      paths.push_back(base::StringPrintf("/%zu%s", i, key.second.c_str()));
+    conversion_callback =
+        base::BindOnce(&ConvertMultiUint64ToString, std::move(paths));
+  }
+
+  std::string json_payload;
+  base::JSONWriter::Write(payload, &json_payload);
+  RequestInternal(
+      json_payload, true, key.first,
+      base::BindOnce(&JsonRpcService::OnBatchResult,
+                     weak_ptr_factory_.GetWeakPtr(), key, std::move(batch)),
+      std::move(conversion_callback));
+}
+
+void JsonRpcService::SendUnbatched(const BatchKey& key,
+                                   BatchedRequest request) {
+  APIRequestHelper::ResponseConversionCallback conversion_callback;
+  if (!key.second.empty())
+    conversion_callback = base::BindOnce(&ConvertUint64ToString, key.second);
+  RequestInternal(request.json_payload, true, key.first,
+                  std::move(request.callback), std::move(conversion_callback));
+}
+
+void JsonRpcService::OnBatchResult(const BatchKey& key,
+                                   std::vector<BatchedRequest> requests,
+                                   APIRequestResult api_request_result) {
+  // A failed batch fails every call in it. Re-sending the calls one by one
+  // would only multiply the load on an endpoint which is rate limiting us or
+  // which we can't reach.
+  if (!api_request_result.Is2XXResponseCode()) {
+    for (auto& request : requests)
+      std::move(request.callback).Run(api_request_result);
+    return;
+  }
+
+  // Not every endpoint supports batches, fall back to sending the calls one
+  // by one so that each of them gets its own response or error, and stop
+  // batching calls to this endpoint.
+  auto response = base::JSONReader::Read(api_request_result.body());
+  if (!response || !response->is_list()) {
+    batch_unsupported_urls_.insert(key.first);
+    for (auto& request : requests)
+      SendUnbatched(key, std::move(request));
+    return;
+  }
+
+  for (auto& entry : response->GetList()) {
+    if (!entry.is_dict())
+      continue;
+    auto index = entry.GetDict().FindInt("id");
+    if (!index || *index < 0 ||
+        static_cast<size_t>(*index) >= requests.size() ||
+        !requests[*index].callback) {
+      continue;
+    }
+    auto& request = requests[*index];
+    entry.GetDict().Set("id", std::move(request.id));
+    std::string body;
+    base::JSONWriter::Write(entry, &body);
+    std::move(request.callback)
+        .Run(APIRequestResult(api_request_result.response_code(),
+                              std::move(body), api_request_result.headers(),
+                              api_request_result.error_code(),
+                              api_request_result.final_url()));
+  }
+
+  // Calls which were left out of the batch response are retried on their own.
+  for (auto& request : requests) {
+    if (request.callback)
+      SendUnbatched(key, std::move(request));
+  }
+}
+
+JsonRpcService::CachedResponse::CachedResponse(APIRequestResult result,
+                                               base::TimeTicks expiration,
+                                               bool block_scoped)
+    : result(std::move(result)),
+      expiration(expiration),
+      block_scoped(block_scoped) {}
+JsonRpcService::CachedResponse::CachedResponse(const CachedResponse&) =
+    default;
+JsonRpcService::CachedResponse& JsonRpcService::CachedResponse::operator=(
+    const CachedResponse&) = default;
+JsonRpcService::CachedResponse::~CachedResponse() = default;
+
+void JsonRpcService::RequestCached(const std::string& json_payload,
+                                   bool auto_retry_on_network_change,
+                                   const GURL& network_url,
+                                   ResponseCacheScope scope,
+                                   RequestIntermediateCallback callback) {
+  std::string method;
+  std::string params;
+  if (!base::FeatureList::IsEnabled(
+          features::kBraveWalletJsonRpcCacheFeature) ||
+      !GetEthJsonRequestInfo(json_payload, nullptr, &method, &params)) {
+    RequestInternal(json_payload, auto_retry_on_network_change, network_url,
+                    std::move(callback));
+    return;
+  }
+
+  CacheKey key(network_url, method + params);
+  auto network_it = cached_responses_.find(network_url);
+  if (network_it != cached_responses_.end()) {
+    auto it = network_it->second.find(key.second);
+    if (it != network_it->second.end()) {
+      if (base::TimeTicks::Now() < it->second.expiration) {
+        base::SequencedTaskRunnerHandle::Get()->PostTask(
+            FROM_HERE, base::BindOnce(&JsonRpcService::RunCachedCallback,
+                                      weak_ptr_factory_.GetWeakPtr(),
+                                      std::move(callback), it->second.result));
+        return;
+      }
+      network_it->second.erase(it);
+    }
+  }
+
+  auto& callbacks = cached_requests_in_flight_[key];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1)
+    return;
+
+  RequestInternal(
+      json_payload, auto_retry_on_network_change, network_url,
+      base::BindOnce(&JsonRpcService::OnCachedRequestResult,
+                     weak_ptr_factory_.GetWeakPtr(), key, method, scope));
+}
+
+void JsonRpcService::RunCachedCallback(
+    RequestIntermediateCallback callback,
+    APIRequestResult api_request_result) {
+  std::move(callback).Run(std::move(api_request_result));
+}
+
+void JsonRpcService::OnCachedRequestResult(
+    const CacheKey& key,
+    const std::string& method,
+    ResponseCacheScope scope,
+    APIRequestResult api_request_result) {
+  std::vector<RequestIntermediateCallback> callbacks;
+  auto in_flight_it = cached_requests_in_flight_.find(key);
+  if (in_flight_it != cached_requests_in_flight_.end()) {
+    callbacks = std::move(in_flight_it->second);
+    cached_requests_in_flight_.erase(in_flight_it);
+  }
+
+  if (IsCacheableResponse(api_request_result)) {
+    const GURL& network_url = key.first;
+    auto& cache = cached_responses_[network_url];
+    uint256_t block_number;
+    if (method == kEthBlockNumber &&
+        eth::ParseEthGetBlockNumber(api_request_result.body(),
+                                    &block_number)) {
+      auto block_it = latest_block_numbers_.find(network_url);
+      if (block_it == latest_block_numbers_.end()) {
+        latest_block_numbers_[network_url] = block_number;
+      } else if (block_it->second != block_number) {
+        block_it->second = block_number;
+        base::EraseIf(cache, [](const auto& entry) {
+          return entry.second.block_scoped;
+        });
+      }
+    }
+
+    const auto now = base::TimeTicks::Now();
+    if (cache.size() >= kMaxCachedResponsesPerNetwork) {
+      base::EraseIf(cache, [now](const auto& entry) {
+        return entry.second.expiration <= now;
+      });
+      if (cache.size() >= kMaxCachedResponsesPerNetwork)
+        cache.clear();
+    }
+
+    base::TimeDelta ttl;
+    switch (scope) {
+      case ResponseCacheScope::kShortLived:
+        ttl = kShortLivedResponseCacheTtl;
+        break;
+      case ResponseCacheScope::kBlock:
+        ttl = kBlockResponseCacheTtl;
+        break;
+      case ResponseCacheScope::kImmutable:
+        ttl = kImmutableResponseCacheTtl;
+        break;
+    }
+    cache.insert_or_assign(
+        key.second, CachedResponse(api_request_result, now + ttl,
+                                   scope == ResponseCacheScope::kBlock));
+  }
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(api_request_result);
+}
+
 void JsonRpcService::Request(const std::string& json_payload,
                              bool auto_retry_on_network_change,
                              base::Value id,
                              mojom::CoinType coin,
                              RequestCallback callback) {
-  RequestInternal(
-      json_payload, auto_retry_on_network_change, network_urls_[coin],
+  auto internal_callback =
       base::BindOnce(&JsonRpcService::OnRequestResult, base::Unretained(this),
-                     std::move(callback), std::move(id)));
+                     std::move(callback), std::move(id));
+  std::string method;
+  if (coin == mojom::CoinType::ETH &&
+      GetEthJsonRequestInfo(json_payload, nullptr, &method, nullptr)) {
+    absl::optional<ResponseCacheScope> scope;
+    if (method == kEthBlockNumber)
+      scope = ResponseCacheScope::kShortLived;
+    else if (method == kEthGasPrice || method == kEthFeeHistory)
+      scope = ResponseCacheScope::kBlock;
+    else if (method == kEthChainId)
+      scope = ResponseCacheScope::kImmutable;
+    if (scope) {
+      RequestCached(json_payload, auto_retry_on_network_change,
+                    network_urls_[coin], *scope, std::move(internal_callback));
+      return;
+    }
+  }
+
+  RequestInternal(json_payload, auto_retry_on_network_change,
+                  network_urls_[coin], std::move(internal_callback));
 }
 
 void JsonRpcService::OnRequestResult(RequestCallback callback,
@@ -344,7 +662,8 @@ void JsonRpcService::AddChain(mojom::NetworkInfoPtr chain,
   auto result = base::BindOnce(&JsonRpcService::OnEthChainIdValidated,
                                weak_ptr_factory_.GetWeakPtr(), std::move(chain),
                                url, std::move(callback));
-  RequestInternal(eth::eth_chainId(), true, url, std::move(result));
+  RequestCached(eth::eth_chainId(), true, url, ResponseCacheScope::kImmutable,
+                std::move(result));
 }
 
 void JsonRpcService::OnEthChainIdValidated(
@@ -416,7 +735,8 @@ void JsonRpcService::AddEthereumChainRequestCompleted(
 
   auto result = base::BindOnce(&JsonRpcService::OnEthChainIdValidatedForOrigin,
                                weak_ptr_factory_.GetWeakPtr(), chain_id, url);
-  RequestInternal(eth::eth_chainId(), true, url, std::move(result));
+  RequestCached(eth::eth_chainId(), true, url, ResponseCacheScope::kImmutable,
+                std::move(result));
 }
 
 void JsonRpcService::OnEthChainIdValidatedForOrigin(
@@ -615,9 +935,9 @@ void JsonRpcService::GetBlockNumber(GetBlockNumberCallback callback) {
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetBlockNumber,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_blockNumber(), true,
-                  network_urls_[mojom::CoinType::ETH],
-                  std::move(internal_callback));
+  RequestCached(eth::eth_blockNumber(), true,
+                network_urls_[mojom::CoinType::ETH],
+                ResponseCacheScope::kShortLived, std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetFilStateSearchMsgLimited(
@@ -671,10 +991,10 @@ void JsonRpcService::GetFeeHistory(GetFeeHistoryCallback callback) {
       base::BindOnce(&JsonRpcService::OnGetFeeHistory,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
 
-  RequestInternal(
-      eth::eth_feeHistory("0x28",  // blockCount = 40
-                          "latest", std::vector<double>{20, 50, 80}),
-      true, network_urls_[mojom::CoinType::ETH], std::move(internal_callback));
+  RequestCached(eth::eth_feeHistory("0x28",  // blockCount = 40
+                                    "latest", std::vector<double>{20, 50, 80}),
+                true, network_urls_[mojom::CoinType::ETH],
+                ResponseCacheScope::kBlock, std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetFeeHistory(GetFeeHistoryCallback callback,
@@ -922,9 +1242,9 @@ void JsonRpcService::GetTransactionReceipt(const std::string& tx_hash,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetTransactionReceipt,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_getTransactionReceipt(tx_hash), true,
-                  network_urls_[mojom::CoinType::ETH],
-                  std::move(internal_callback));
+  RequestBatched(eth::eth_getTransactionReceipt(tx_hash),
+                 network_urls_[mojom::CoinType::ETH], "",
+                 std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetTransactionReceipt(
@@ -998,8 +1318,8 @@ void JsonRpcService::GetERC20TokenBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract, "", "", "", data, "latest"), true,
-                  network_url, std::move(internal_callback));
+  RequestBatched(eth::eth_call("", contract, "", "", "", data, "latest"),
+                 network_url, "", std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenBalance(
@@ -1673,9 +1993,9 @@ void JsonRpcService::GetGasPrice(GetGasPriceCallback callback) {
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetGasPrice,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_gasPrice(), true,
-                  network_urls_[mojom::CoinType::ETH],
-                  std::move(internal_callback));
+  RequestCached(eth::eth_gasPrice(), true,
+                network_urls_[mojom::CoinType::ETH], ResponseCacheScope::kBlock,
+                std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetGasPrice(GetGasPriceCallback callback,
@@ -1776,8 +2096,8 @@ void JsonRpcService::GetERC721OwnerOf(const std::string& contract,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC721OwnerOf,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract, "", "", "", data, "latest"), true,
-                  network_url, std::move(internal_callback));
+  RequestBatched(eth::eth_call("", contract, "", "", "", data, "latest"),
+                 network_url, "", std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC721OwnerOf(GetERC721OwnerOfCallback callback,
@@ -1943,9 +2263,10 @@ void JsonRpcService::OnGetSupportsInterfaceTokenMetadata(
       base::BindOnce(&JsonRpcService::OnGetTokenUri,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
 
-  RequestInternal(eth::eth_call("", contract_address, "", "", "",
-                                function_signature, "latest"),
-                  true, network_url, std::move(internal_callback));
+  RequestCached(eth::eth_call("", contract_address, "", "", "",
+                              function_signature, "latest"),
+                true, network_url, ResponseCacheScope::kImmutable,
+                std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetTokenUri(GetTokenMetadataCallback callback,
@@ -2092,9 +2413,9 @@ void JsonRpcService::GetERC1155TokenBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnEthGetBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(
-      eth::eth_call("", contract_address, "", "", "", data, "latest"), true,
-      network_url, std::move(internal_callback));
+  RequestBatched(
+      eth::eth_call("", contract_address, "", "", "", data, "latest"),
+      network_url, "", std::move(internal_callback));
 }
 
 // Called by KeyringService::CreateWallet, KeyringService::RestoreWallet,
@@ -2162,23 +2483,6 @@ void JsonRpcService::DiscoverAssetsInternal(
     }
   }
 
-  std::vector<mojom::BlockchainTokenPtr> user_assets =
-      BraveWalletService::GetUserAssets(chain_id, mojom::CoinType::ETH, prefs_);
-  auto internal_callback = base::BindOnce(
-      &JsonRpcService::OnGetAllTokensDiscoverAssets,
-      weak_ptr_factory_.GetWeakPtr(), chain_id, account_addresses,
-      std::move(user_assets), std::move(callback));
-
-  BlockchainRegistry::GetInstance()->GetAllTokens(
-      chain_id, mojom::CoinType::ETH, std::move(internal_callback));
-}
-
-void JsonRpcService::OnGetAllTokensDiscoverAssets(
-    const std::string& chain_id,
-    const std::vector<std::string>& account_addresses,
-    std::vector<mojom::BlockchainTokenPtr> user_assets,
-    DiscoverAssetsCallback callback,
-    std::vector<mojom::BlockchainTokenPtr> token_registry) {
   auto network_url = GetNetworkURL(prefs_, chain_id, mojom::CoinType::ETH);
   if (!network_url.is_valid()) {
     std::move(callback).Run(
@@ -2198,6 +2502,8 @@ void JsonRpcService::OnGetAllTokensDiscoverAssets(
   }
 
   // Create set of contract addresses the user already has for easy lookups
+  std::vector<mojom::BlockchainTokenPtr> user_assets =
+      BraveWalletService::GetUserAssets(chain_id, mojom::CoinType::ETH, prefs_);
   base::flat_set<std::string> user_asset_contract_addresses;
   for (const auto& user_asset : user_assets) {
     user_asset_contract_addresses.insert(user_asset->contract_address);
@@ -2205,20 +2511,27 @@ void JsonRpcService::OnGetAllTokensDiscoverAssets(
 
   // Create a list of contract addresses to search by removing
   // all erc20s and assets the user has already added.
+  // The registry token list is only read here, tokens which are discovered
+  // are looked up again in OnGetTransferLogs.
   base::Value::List contract_addresses_to_search;
-  // Also create a map for addresses to blockchain tokens for easy lookup
-  // for blockchain tokens in OnGetTransferLogs
-  base::flat_map<std::string, mojom::BlockchainTokenPtr> tokens_to_search;
-  for (auto& registry_token : token_registry) {
-    if (registry_token->is_erc20 && !registry_token->contract_address.empty() &&
-        !user_asset_contract_addresses.contains(
-            registry_token->contract_address)) {
-      // Use lowercase representation of hex address for comparisons
-      // because providers may return all lowercase addresses.
-      const std::string lower_case_contract_address =
-          base::ToLowerASCII(registry_token->contract_address);
-      contract_addresses_to_search.Append(lower_case_contract_address);
-      tokens_to_search[lower_case_contract_address] = std::move(registry_token);
+  base::flat_set<std::string> tokens_to_search;
+  const auto* token_registry = BlockchainRegistry::GetInstance()->GetTokenList(
+      chain_id, mojom::CoinType::ETH);
+  if (token_registry) {
+    for (const auto& registry_token : *token_registry) {
+      if (registry_token->is_erc20 &&
+          !registry_token->contract_address.empty() &&
+          !user_asset_contract_addresses.contains(
+              registry_token->contract_address)) {
+        // Use lowercase representation of hex address for comparisons
+        // because providers may return all lowercase addresses.
+        std::string lower_case_contract_address =
+            base::ToLowerASCII(registry_token->contract_address);
+        if (tokens_to_search.insert(lower_case_contract_address).second) {
+          contract_addresses_to_search.Append(
+              std::move(lower_case_contract_address));
+        }
+      }
     }
   }
 
@@ -2230,7 +2543,7 @@ void JsonRpcService::OnGetAllTokensDiscoverAssets(
 
   auto internal_callback = base::BindOnce(
       &JsonRpcService::OnGetTransferLogs, weak_ptr_factory_.GetWeakPtr(),
-      std::move(callback), base::OwnedRef(std::move(tokens_to_search)));
+      std::move(callback), chain_id, std::move(tokens_to_search));
 
   RequestInternal(eth::eth_getLogs("earliest", "latest",
                                    std::move(contract_addresses_to_search),
@@ -2240,7 +2553,8 @@ void JsonRpcService::OnGetAllTokensDiscoverAssets(
 
 void JsonRpcService::OnGetTransferLogs(
     DiscoverAssetsCallback callback,
-    base::flat_map<std::string, mojom::BlockchainTokenPtr>& tokens_to_search,
+    const std::string& chain_id,
+    const base::flat_set<std::string>& tokens_to_search,
     APIRequestResult api_request_result) {
   if (!api_request_result.Is2XXResponseCode()) {
     std::move(callback).Run(
@@ -2265,12 +2579,16 @@ void JsonRpcService::OnGetTransferLogs(
   }
   std::vector<mojom::BlockchainTokenPtr> discovered_assets;
 
+  auto* blockchain_registry = BlockchainRegistry::GetInstance();
   for (const auto& contract_address : matching_contract_addresses) {
     if (!tokens_to_search.contains(contract_address)) {
       continue;
     }
-    mojom::BlockchainTokenPtr token =
-        std::move(tokens_to_search.at(contract_address));
+    mojom::BlockchainTokenPtr token = blockchain_registry->GetTokenByAddress(
+        chain_id, mojom::CoinType::ETH, contract_address);
+    if (!token) {
+      continue;
+    }
 
     if (!BraveWalletService::AddUserAsset(token.Clone(), prefs_)) {
       continue;
@@ -2308,9 +2626,10 @@ void JsonRpcService::GetSupportsInterface(
       base::BindOnce(&JsonRpcService::OnGetSupportsInterface,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
   DCHECK(network_urls_.contains(mojom::CoinType::ETH));
-  RequestInternal(
+  RequestCached(
       eth::eth_call("", contract_address, "", "", "", data, "latest"), true,
-      network_url, std::move(internal_callback));
+      network_url, ResponseCacheScope::kImmutable,
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetSupportsInterface(
@@ -2422,6 +2741,8 @@ bool JsonRpcService::AddSwitchEthereumChainRequest(const std::string& chain_id,
 
 void JsonRpcService::Reset() {
   ClearJsonRpcServiceProfilePrefs(prefs_);
+  cached_responses_.clear();
+  latest_block_numbers_.clear();
   SetNetwork(GetCurrentChainId(prefs_, mojom::CoinType::ETH),
              mojom::CoinType::ETH);
 
@@ -2455,9 +2776,8 @@ void JsonRpcService::GetSolanaBalance(const std::string& pubkey,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetSolanaBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getBalance(pubkey), true, network_url,
-                  std::move(internal_callback),
-                  base::BindOnce(&ConvertUint64ToString, "/result/value"));
+  RequestBatched(solana::getBalance(pubkey), network_url, "/result/value",
+                 std::move(internal_callback));
 }
 
 void JsonRpcService::GetSPLTokenAccountBalance(
@@ -2486,8 +2806,8 @@ void JsonRpcService::GetSPLTokenAccountBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetSPLTokenAccountBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getTokenAccountBalance(*associated_token_account),
-                  true, network_url, std::move(internal_callback));
+  RequestBatched(solana::getTokenAccountBalance(*associated_token_account),
+                 network_url, "", std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetSolanaBalance(GetSolanaBalanceCallback callback,
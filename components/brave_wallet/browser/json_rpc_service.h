@@ -14,8 +14,11 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
+#include "base/time/time.h"
+#include "base/values.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/ens_resolver_task.h"
@@ -320,17 +323,10 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
                               const std::vector<std::string>& account_addresses,
                               DiscoverAssetsCallback callback);
 
-  void OnGetAllTokensDiscoverAssets(
-      const std::string& chain_id,
-      const std::vector<std::string>& account_addresses,
-      std::vector<mojom::BlockchainTokenPtr> user_assets,
-      DiscoverAssetsCallback callback,
-      std::vector<mojom::BlockchainTokenPtr> token_list);
-
-  void OnGetTransferLogs(
-      DiscoverAssetsCallback callback,
-      base::flat_map<std::string, mojom::BlockchainTokenPtr>& user_assets_map,
-      APIRequestResult api_request_result);
+  void OnGetTransferLogs(DiscoverAssetsCallback callback,
+                         const std::string& chain_id,
+                         const base::flat_set<std::string>& tokens_to_search,
+                         APIRequestResult api_request_result);
 
   void OnDiscoverAssetsCompleted(
       std::vector<mojom::BlockchainTokenPtr> discovered_assets,
@@ -498,6 +494,80 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const GURL& network_url,
       RequestIntermediateCallback callback,
       APIRequestHelper::ResponseConversionCallback conversion_callback);
+
+  // A call waiting to be sent as part of a JSON-RPC batch.
+  struct BatchedRequest {
+    BatchedRequest(std::string json_payload,
+                   RequestIntermediateCallback callback);
+    BatchedRequest(BatchedRequest&&);
+    BatchedRequest& operator=(BatchedRequest&&);
+    ~BatchedRequest();
+
+    std::string json_payload;
+    RequestIntermediateCallback callback;
+    // Id of |json_payload|, restored in the response handed to |callback|.
+    base::Value id;
+  };
+  // <network_url, uint64_result_path>
+  using BatchKey = std::pair<GURL, std::string>;
+
+  // Like RequestInternal, but calls made to the same endpoint within the same
+  // task are coalesced into a single JSON-RPC batch request. Each callback is
+  // run with its own response, as if the call had been sent on its own.
+  // A non-empty |uint64_result_path| is converted to a string before parsing,
+  // see ConvertUint64ToString.
+  void RequestBatched(const std::string& json_payload,
+                      const GURL& network_url,
+                      const std::string& uint64_result_path,
+                      RequestIntermediateCallback callback);
+  void FlushBatchedRequests(const BatchKey& key);
+  void SendBatch(const BatchKey& key, std::vector<BatchedRequest> requests);
+  void SendUnbatched(const BatchKey& key, BatchedRequest request);
+  void OnBatchResult(const BatchKey& key,
+                     std::vector<BatchedRequest> requests,
+                     APIRequestResult api_request_result);
+
+  // How long a successful response to an idempotent call is reused for.
+  enum class ResponseCacheScope {
+    // A few seconds, e.g. the latest block number.
+    kShortLived,
+    // Until a new block is seen on the network, e.g. gas prices.
+    kBlock,
+    // Values which don't change for a network, e.g. chain ids and token URIs.
+    kImmutable,
+  };
+  struct CachedResponse {
+    CachedResponse(APIRequestResult result,
+                   base::TimeTicks expiration,
+                   bool block_scoped);
+    CachedResponse(const CachedResponse&);
+    CachedResponse& operator=(const CachedResponse&);
+    ~CachedResponse();
+
+    APIRequestResult result;
+    base::TimeTicks expiration;
+    bool block_scoped = false;
+  };
+  // <network_url, method + params>
+  using CacheKey = std::pair<GURL, std::string>;
+
+  // Like RequestInternal, but successful responses are cached per network for
+  // |scope| and concurrent identical calls share a single network fetch.
+  // Calls are identified by method and params, ids are ignored.
+  void RequestCached(const std::string& json_payload,
+                     bool auto_retry_on_network_change,
+                     const GURL& network_url,
+                     ResponseCacheScope scope,
+                     RequestIntermediateCallback callback);
+  // Callers may bind |this| unretained, so cache hits are delivered through
+  // a weak pointer in case the service is gone before the task runs.
+  void RunCachedCallback(RequestIntermediateCallback callback,
+                         APIRequestResult api_request_result);
+  void OnCachedRequestResult(const CacheKey& key,
+                             const std::string& method,
+                             ResponseCacheScope scope,
+                             APIRequestResult api_request_result);
+
   void OnEthChainIdValidatedForOrigin(const std::string& chain_id,
                                       const GURL& rpc_url,
                                       APIRequestResult api_request_result);
@@ -564,6 +634,17 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   std::unique_ptr<APIRequestHelper> api_request_helper_;
   std::unique_ptr<APIRequestHelper> api_request_helper_ens_offchain_;
   base::flat_map<mojom::CoinType, GURL> network_urls_;
+  base::flat_map<BatchKey, std::vector<BatchedRequest>> batched_requests_;
+  // Endpoints which did not answer a batch with an array, calls to them are
+  // always sent on their own.
+  base::flat_set<GURL> batch_unsupported_urls_;
+  base::flat_map<GURL, base::flat_map<std::string, CachedResponse>>
+      cached_responses_;
+  base::flat_map<CacheKey, std::vector<RequestIntermediateCallback>>
+      cached_requests_in_flight_;
+  // Latest block number seen per network, block scoped responses are dropped
+  // when it changes.
+  base::flat_map<GURL, uint256_t> latest_block_numbers_;
   // <mojom::CoinType, chain_id>
   base::flat_map<mojom::CoinType, std::string> chain_ids_;
   // <chain_id, mojom::AddChainRequest>
@@ -4,7 +4,9 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <stdint.h>
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -16,6 +18,8 @@
 #include "base/json/json_writer.h"
 #include "base/notreached.h"
 #include "base/ranges/algorithm.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/mock_callback.h"
@@ -327,6 +331,26 @@ absl::optional<base::Value> ToValue(const network::ResourceRequest& request) {
                                 base::JSONParserOptions::JSON_PARSE_RFC);
 }
 
+// Answers a single call made to the JSON-RPC stand-in of the batching tests.
+// eth_call returns the last digit of the contract address as a uint256.
+std::string MakeJsonRpcStandInResponse(const base::Value::Dict& call) {
+  const std::string* method = call.FindString("method");
+  const base::Value::List* params = call.FindList("params");
+  std::string result = "null";
+  if (method && params && !params->empty()) {
+    const base::Value& first_param = (*params)[0];
+    if (*method == "eth_call" && first_param.is_dict()) {
+      const std::string* to = first_param.GetDict().FindString("to");
+      if (to && !to->empty())
+        result = "\"0x" + std::string(63, '0') + to->back() + "\"";
+    } else if (*method == "getBalance") {
+      result = R"({"context":{"slot":1},"value":18446744073709551615})";
+    }
+  }
+  return base::StringPrintf(R"({"jsonrpc":"2.0","id":%d,"result":%s})",
+                            call.FindInt("id").value_or(0), result.c_str());
+}
+
 std::vector<brave_wallet::mojom::NetworkInfoPtr> GetAllEthCustomChains(
     PrefService* prefs) {
   return GetAllCustomChains(prefs, brave_wallet::mojom::CoinType::ETH);
@@ -337,6 +361,9 @@ std::vector<brave_wallet::mojom::NetworkInfoPtr> GetAllEthCustomChains(
 class JsonRpcServiceUnitTest : public testing::Test {
  public:
   JsonRpcServiceUnitTest() = default;
+  explicit JsonRpcServiceUnitTest(
+      base::test::TaskEnvironment::TimeSource time_source)
+      : task_environment_(time_source) {}
 
   void SetUp() override {
     Test::SetUp();
@@ -606,6 +633,43 @@ class JsonRpcServiceUnitTest : public testing::Test {
         }));
   }
 
+  // Stand-in for a JSON-RPC endpoint which counts the HTTP requests it gets.
+  // Batches are answered in reverse order, or rejected as a whole when
+  // |supports_batches| is false.
+  void SetJsonRpcStandInInterceptor(bool supports_batches,
+                                    size_t* num_requests) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, supports_batches,
+         num_requests](const network::ResourceRequest& request) {
+          ++*num_requests;
+          auto payload = ToValue(request);
+          ASSERT_TRUE(payload);
+          url_loader_factory_.ClearResponses();
+          if (payload->is_dict()) {
+            url_loader_factory_.AddResponse(
+                request.url.spec(),
+                MakeJsonRpcStandInResponse(payload->GetDict()));
+            return;
+          }
+          ASSERT_TRUE(payload->is_list());
+          if (!supports_batches) {
+            url_loader_factory_.AddResponse(
+                request.url.spec(),
+                R"({"jsonrpc":"2.0","id":null,"error":{
+                    "code":-32600,"message":"Invalid request"}})");
+            return;
+          }
+          std::vector<std::string> responses;
+          for (const auto& call : payload->GetList()) {
+            ASSERT_TRUE(call.is_dict());
+            responses.push_back(MakeJsonRpcStandInResponse(call.GetDict()));
+          }
+          std::reverse(responses.begin(), responses.end());
+          url_loader_factory_.AddResponse(
+              request.url.spec(), "[" + base::JoinString(responses, ",") + "]");
+        }));
+  }
+
   void SetInvalidJsonInterceptor() {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&](const network::ResourceRequest& request) {
@@ -1058,6 +1122,8 @@ class JsonRpcServiceUnitTest : public testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment& task_environment() { return task_environment_; }
+
   std::unique_ptr<JsonRpcService> json_rpc_service_;
   network::TestURLLoaderFactory url_loader_factory_;
 
@@ -3636,6 +3702,318 @@ TEST_F(JsonRpcServiceUnitTest, GetSPLTokenAccountBalance) {
       l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR));
 }
 
+TEST_F(JsonRpcServiceUnitTest, BatchesConcurrentRequests) {
+  size_t num_requests = 0;
+  SetJsonRpcStandInInterceptor(true, &num_requests);
+
+  std::vector<std::string> token_balances(3);
+  for (size_t i = 0; i < token_balances.size(); ++i) {
+    json_rpc_service_->GetERC20TokenBalance(
+        base::StringPrintf("0x0d8775f648430679a709e98d2b0cb6250d2887e%zu",
+                           i + 1),
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::kMainnetChainId,
+        base::BindLambdaForTesting([&, i](const std::string& balance,
+                                          mojom::ProviderError error,
+                                          const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          token_balances[i] = balance;
+        }));
+  }
+  std::vector<uint64_t> sol_balances;
+  for (const char* pubkey : {"test_public_key1", "test_public_key2"}) {
+    json_rpc_service_->GetSolanaBalance(
+        pubkey, mojom::kSolanaMainnet,
+        base::BindLambdaForTesting([&](uint64_t balance,
+                                       mojom::SolanaProviderError error,
+                                       const std::string& error_message) {
+          EXPECT_EQ(error, mojom::SolanaProviderError::kSuccess);
+          sol_balances.push_back(balance);
+        }));
+  }
+  EXPECT_EQ(num_requests, 0u);
+  base::RunLoop().RunUntilIdle();
+
+  // A single batch per endpoint.
+  EXPECT_EQ(num_requests, 2u);
+  EXPECT_EQ(token_balances, std::vector<std::string>({"0x1", "0x2", "0x3"}));
+  EXPECT_EQ(sol_balances, std::vector<uint64_t>({UINT64_MAX, UINT64_MAX}));
+
+  // Calls made in separate tasks are not held back for each other.
+  num_requests = 0;
+  for (size_t i = 0; i < 2; ++i) {
+    TestGetSolanaBalance(UINT64_MAX, mojom::SolanaProviderError::kSuccess, "");
+  }
+  EXPECT_EQ(num_requests, 2u);
+}
+
+TEST_F(JsonRpcServiceUnitTest, BatchFallsBackToSingleRequests) {
+  size_t num_requests = 0;
+  SetJsonRpcStandInInterceptor(false, &num_requests);
+
+  std::vector<std::string> token_balances(3);
+  for (size_t i = 0; i < token_balances.size(); ++i) {
+    json_rpc_service_->GetERC20TokenBalance(
+        base::StringPrintf("0x0d8775f648430679a709e98d2b0cb6250d2887e%zu",
+                           i + 1),
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::kMainnetChainId,
+        base::BindLambdaForTesting([&, i](const std::string& balance,
+                                          mojom::ProviderError error,
+                                          const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          token_balances[i] = balance;
+        }));
+  }
+  base::RunLoop().RunUntilIdle();
+
+  // The rejected batch, then a request per call.
+  EXPECT_EQ(num_requests, 4u);
+  EXPECT_EQ(token_balances, std::vector<std::string>({"0x1", "0x2", "0x3"}));
+
+  // The endpoint is no longer sent batches.
+  num_requests = 0;
+  token_balances.assign(3, "");
+  for (size_t i = 0; i < token_balances.size(); ++i) {
+    json_rpc_service_->GetERC20TokenBalance(
+        base::StringPrintf("0x0d8775f648430679a709e98d2b0cb6250d2887e%zu",
+                           i + 1),
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::kMainnetChainId,
+        base::BindLambdaForTesting([&, i](const std::string& balance,
+                                          mojom::ProviderError error,
+                                          const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          token_balances[i] = balance;
+        }));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(num_requests, 3u);
+  EXPECT_EQ(token_balances, std::vector<std::string>({"0x1", "0x2", "0x3"}));
+}
+
+TEST_F(JsonRpcServiceUnitTest, FailedBatchFailsEveryCall) {
+  size_t num_requests = 0;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        ++num_requests;
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(), "",
+                                        net::HTTP_TOO_MANY_REQUESTS);
+      }));
+
+  size_t num_errors = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    json_rpc_service_->GetERC20TokenBalance(
+        base::StringPrintf("0x0d8775f648430679a709e98d2b0cb6250d2887e%zu",
+                           i + 1),
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::kMainnetChainId,
+        base::BindLambdaForTesting([&](const std::string& balance,
+                                       mojom::ProviderError error,
+                                       const std::string& error_message) {
+          EXPECT_NE(error, mojom::ProviderError::kSuccess);
+          EXPECT_TRUE(balance.empty());
+          ++num_errors;
+        }));
+  }
+  base::RunLoop().RunUntilIdle();
+
+  // The calls are not re-sent on their own.
+  EXPECT_EQ(num_requests, 1u);
+  EXPECT_EQ(num_errors, 3u);
+}
+
+class JsonRpcServiceCacheUnitTest : public JsonRpcServiceUnitTest {
+ public:
+  JsonRpcServiceCacheUnitTest()
+      : JsonRpcServiceUnitTest(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+    feature_list_.InitAndEnableFeature(
+        features::kBraveWalletJsonRpcCacheFeature);
+  }
+
+  void SetUp() override {
+    JsonRpcServiceUnitTest::SetUp();
+    // Answers each method with the result set in |results_| and counts the
+    // requests made for it.
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&](const network::ResourceRequest& request) {
+          auto payload = ToValue(request);
+          ASSERT_TRUE(payload && payload->is_dict());
+          const std::string* method = payload->GetDict().FindString("method");
+          ASSERT_TRUE(method);
+          ++num_requests_[*method];
+          url_loader_factory_.ClearResponses();
+          auto it = results_.find(*method);
+          if (it == results_.end()) {
+            url_loader_factory_.AddResponse(
+                request.url.spec(),
+                R"({"jsonrpc":"2.0","id":1,"error":{"code":-32005,
+                    "message":"Request exceeds defined limit"}})");
+            return;
+          }
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              base::StringPrintf(R"({"jsonrpc":"2.0","id":1,"result":"%s"})",
+                                 it->second.c_str()));
+        }));
+  }
+
+  std::string GetGasPrice() {
+    std::string gas_price;
+    base::RunLoop run_loop;
+    json_rpc_service_->GetGasPrice(base::BindLambdaForTesting(
+        [&](const std::string& result, mojom::ProviderError error,
+            const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          gas_price = result;
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return gas_price;
+  }
+
+  uint256_t GetBlockNumber() {
+    uint256_t block_number = 0;
+    base::RunLoop run_loop;
+    json_rpc_service_->GetBlockNumber(base::BindLambdaForTesting(
+        [&](uint256_t result, mojom::ProviderError error,
+            const std::string& error_message) {
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          block_number = result;
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return block_number;
+  }
+
+  mojom::ProviderError GetSupportsInterface() {
+    mojom::ProviderError provider_error = mojom::ProviderError::kUnknown;
+    base::RunLoop run_loop;
+    json_rpc_service_->GetSupportsInterface(
+        "0x06012c8cf97BEaD5deAe237070F9587f8E7A266d", "0x80ac58cd",
+        mojom::kMainnetChainId,
+        base::BindLambdaForTesting([&](bool is_supported,
+                                       mojom::ProviderError error,
+                                       const std::string& error_message) {
+          provider_error = error;
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return provider_error;
+  }
+
+ protected:
+  base::flat_map<std::string, std::string> results_;
+  base::flat_map<std::string, int> num_requests_;
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+TEST_F(JsonRpcServiceCacheUnitTest, SharesConcurrentRequests) {
+  results_["eth_gasPrice"] = "0x1";
+
+  int num_callbacks = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    json_rpc_service_->GetGasPrice(base::BindLambdaForTesting(
+        [&](const std::string& result, mojom::ProviderError error,
+            const std::string& error_message) {
+          EXPECT_EQ(result, "0x1");
+          EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+          ++num_callbacks;
+        }));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(num_callbacks, 3);
+  EXPECT_EQ(num_requests_["eth_gasPrice"], 1);
+
+  // Dapp requests with different ids share the cached response.
+  for (int id = 1; id <= 2; ++id) {
+    base::RunLoop run_loop;
+    json_rpc_service_->Request(
+        base::StringPrintf(
+            R"({"jsonrpc":"2.0","id":%d,"method":"eth_gasPrice","params":[]})",
+            id),
+        true, base::Value(id), mojom::CoinType::ETH,
+        base::BindLambdaForTesting(
+            [&](base::Value response_id, base::Value formed_response,
+                bool reject, const std::string& first_allowed_account,
+                bool update_bind_js_properties) {
+              EXPECT_EQ(response_id, base::Value(id));
+              EXPECT_FALSE(reject);
+              EXPECT_EQ(formed_response, base::Value("0x1"));
+              run_loop.Quit();
+            }));
+    run_loop.Run();
+  }
+  EXPECT_EQ(num_requests_["eth_gasPrice"], 1);
+}
+
+TEST_F(JsonRpcServiceCacheUnitTest, DropsBlockScopedResponsesOnNewBlock) {
+  results_["eth_gasPrice"] = "0x1";
+  results_["eth_blockNumber"] = "0x10";
+  EXPECT_EQ(GetGasPrice(), "0x1");
+  EXPECT_EQ(GetBlockNumber(), uint256_t(0x10));
+  EXPECT_EQ(GetGasPrice(), "0x1");
+  EXPECT_EQ(num_requests_["eth_gasPrice"], 1);
+
+  // The block number is only reused for a few seconds.
+  results_["eth_gasPrice"] = "0x2";
+  results_["eth_blockNumber"] = "0x11";
+  EXPECT_EQ(GetBlockNumber(), uint256_t(0x10));
+  EXPECT_EQ(num_requests_["eth_blockNumber"], 1);
+  task_environment().FastForwardBy(base::Seconds(3));
+  EXPECT_EQ(GetBlockNumber(), uint256_t(0x11));
+  EXPECT_EQ(num_requests_["eth_blockNumber"], 2);
+
+  // A new block was seen, so the gas price is fetched again.
+  EXPECT_EQ(GetGasPrice(), "0x2");
+  EXPECT_EQ(num_requests_["eth_gasPrice"], 2);
+
+  // Block scoped responses also expire on their own.
+  results_["eth_gasPrice"] = "0x3";
+  task_environment().FastForwardBy(base::Seconds(16));
+  EXPECT_EQ(GetGasPrice(), "0x3");
+  EXPECT_EQ(num_requests_["eth_gasPrice"], 3);
+}
+
+TEST_F(JsonRpcServiceCacheUnitTest, CachesImmutableResponsesOnly) {
+  // Errors are not cached.
+  EXPECT_EQ(GetSupportsInterface(), mojom::ProviderError::kLimitExceeded);
+  EXPECT_EQ(GetSupportsInterface(), mojom::ProviderError::kLimitExceeded);
+  EXPECT_EQ(num_requests_["eth_call"], 2);
+
+  results_["eth_call"] =
+      "0x0000000000000000000000000000000000000000000000000000000000000001";
+  EXPECT_EQ(GetSupportsInterface(), mojom::ProviderError::kSuccess);
+  task_environment().FastForwardBy(base::Hours(1));
+  EXPECT_EQ(GetSupportsInterface(), mojom::ProviderError::kSuccess);
+  EXPECT_EQ(num_requests_["eth_call"], 3);
+
+  // Reset drops all cached responses.
+  json_rpc_service_->Reset();
+  EXPECT_EQ(GetSupportsInterface(), mojom::ProviderError::kSuccess);
+  EXPECT_EQ(num_requests_["eth_call"], 4);
+}
+
+TEST_F(JsonRpcServiceCacheUnitTest, DropsCachedResponseAfterDestruction) {
+  results_["eth_gasPrice"] = "0x1";
+  EXPECT_EQ(GetGasPrice(), "0x1");
+
+  // A cache hit is answered asynchronously, so the dapp request callback must
+  // not run once the service is gone.
+  bool callback_called = false;
+  json_rpc_service_->Request(
+      R"({"jsonrpc":"2.0","id":1,"method":"eth_gasPrice","params":[]})", true,
+      base::Value(1), mojom::CoinType::ETH,
+      base::BindLambdaForTesting(
+          [&](base::Value response_id, base::Value formed_response,
+              bool reject, const std::string& first_allowed_account,
+              bool update_bind_js_properties) { callback_called = true; }));
+  json_rpc_service_.reset();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(callback_called);
+  EXPECT_EQ(num_requests_["eth_gasPrice"], 1);
+}
+
 TEST_F(JsonRpcServiceUnitTest, SendSolanaTransaction) {
   TestSendSolanaTransaction(
       "", mojom::SolanaProviderError::kInvalidParams,
@@ -8,6 +8,7 @@
 #include <string>
 #include <utility>
 
+#include "base/barrier_callback.h"
 #include "base/base64.h"
 #include "base/hash/hash.h"
 #include "base/logging.h"
@@ -15,6 +16,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
@@ -208,6 +210,15 @@ int GetPbkdf2Iterations() {
       kPbkdf2Iterations);
 }
 
+std::pair<std::string, std::unique_ptr<PasswordEncryptor>>
+DeriveEncryptorForKeyring(const std::string& keyring_id,
+                          const std::string& password,
+                          const std::vector<uint8_t>& salt,
+                          int iterations) {
+  return {keyring_id, PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+                          password, salt, iterations, kPbkdf2KeySize)};
+}
+
 }  // namespace
 
 KeyringService::KeyringService(JsonRpcService* json_rpc_service,
@@ -557,6 +568,15 @@ HDKeyring* KeyringService::ResumeKeyring(const std::string& keyring_id,
     return nullptr;
   }
 
+  return ResumeKeyringInternal(keyring_id);
+}
+
+HDKeyring* KeyringService::ResumeKeyringInternal(
+    const std::string& keyring_id) {
+  if (!encryptors_[keyring_id]) {
+    return nullptr;
+  }
+
   const std::string mnemonic = GetMnemonicForKeyringImpl(keyring_id);
   bool is_legacy_brave_wallet = false;
   const base::Value* value =
@@ -1670,6 +1690,9 @@ absl::optional<std::string> KeyringService::GetFilecoinSelectedAccount(
 }
 
 void KeyringService::Lock() {
+  // An unlock which is still deriving its keys must not unlock the wallet
+  // once they are in.
+  CancelPendingUnlocks();
   if (IsLocked(mojom::kDefaultKeyringId))
     return;
 
@@ -1697,40 +1720,121 @@ bool KeyringService::IsHardwareAccount(const std::string& address) const {
 
 void KeyringService::Unlock(const std::string& password,
                             KeyringService::UnlockCallback callback) {
-  if (!ResumeKeyring(mojom::kDefaultKeyringId, password)) {
-    encryptors_.erase(mojom::kDefaultKeyringId);
+  if (password.empty()) {
     std::move(callback).Run(false);
     return;
   }
 
+  // Unlocks are serialized, each one starts once the previous has finished.
+  pending_unlocks_.emplace_back(password, std::move(callback));
+  if (pending_unlocks_.size() == 1) {
+    StartUnlock();
+  }
+}
+
+void KeyringService::StartUnlock() {
+  DCHECK(!pending_unlocks_.empty());
+  const std::string& password = pending_unlocks_.front().first;
+
+  // Added 08.08.2022
+  MaybeMigratePBKDF2Iterations(password);
+
+  std::vector<std::string> keyring_ids = {mojom::kDefaultKeyringId};
   if (IsFilecoinEnabled()) {
-    if (!ResumeKeyring(mojom::kFilecoinKeyringId, password)) {
+    keyring_ids.push_back(mojom::kFilecoinKeyringId);
+    keyring_ids.push_back(mojom::kFilecoinTestnetKeyringId);
+  }
+  if (IsSolanaEnabled()) {
+    keyring_ids.push_back(mojom::kSolanaKeyringId);
+  }
+
+  // Each keyring has its own salt, so there is one key to derive per keyring.
+  // Derivations are slow by design, so they run in parallel off the UI thread.
+  // Lock and Reset invalidate |weak_ptr_factory_| to drop the results.
+  auto on_encryptor_derived = base::BarrierCallback<
+      std::pair<std::string, std::unique_ptr<PasswordEncryptor>>>(
+      keyring_ids.size(),
+      base::BindOnce(&KeyringService::OnUnlockEncryptorsDerived,
+                     weak_ptr_factory_.GetWeakPtr()));
+  for (const auto& keyring_id : keyring_ids) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&DeriveEncryptorForKeyring, keyring_id, password,
+                       GetOrCreateSaltForKeyring(keyring_id),
+                       GetPbkdf2Iterations()),
+        on_encryptor_derived);
+  }
+}
+
+void KeyringService::OnUnlockEncryptorsDerived(
+    std::vector<std::pair<std::string, std::unique_ptr<PasswordEncryptor>>>
+        derived_encryptors) {
+  DCHECK(!pending_unlocks_.empty());
+  UnlockCallback callback = std::move(pending_unlocks_.front().second);
+  pending_unlocks_.pop_front();
+
+  const bool result = ResumeKeyringsWithEncryptors(
+      base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>(
+          std::move(derived_encryptors)));
+  if (!pending_unlocks_.empty()) {
+    StartUnlock();
+  }
+  std::move(callback).Run(result);
+}
+
+void KeyringService::CancelPendingUnlocks() {
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  auto pending_unlocks = std::move(pending_unlocks_);
+  pending_unlocks_.clear();
+  for (auto& pending_unlock : pending_unlocks) {
+    std::move(pending_unlock.second).Run(false);
+  }
+}
+
+bool KeyringService::ResumeKeyringsWithEncryptors(
+    base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>
+        encryptors) {
+  encryptors_[mojom::kDefaultKeyringId] =
+      std::move(encryptors[mojom::kDefaultKeyringId]);
+  if (!ResumeKeyringInternal(mojom::kDefaultKeyringId)) {
+    encryptors_.erase(mojom::kDefaultKeyringId);
+    return false;
+  }
+
+  if (encryptors.contains(mojom::kFilecoinKeyringId)) {
+    encryptors_[mojom::kFilecoinKeyringId] =
+        std::move(encryptors[mojom::kFilecoinKeyringId]);
+    if (!ResumeKeyringInternal(mojom::kFilecoinKeyringId)) {
       // If Filecoin keyring doesnt exist we keep encryptor pre-created
       // to be able to lazily create keyring later
       if (IsKeyringExist(mojom::kFilecoinKeyringId)) {
         VLOG(1) << __func__ << " Unable to unlock filecoin keyring";
         encryptors_.erase(mojom::kFilecoinKeyringId);
-        std::move(callback).Run(false);
-        return;
+        return false;
       }
     }
+  }
 
-    if (!ResumeKeyring(mojom::kFilecoinTestnetKeyringId, password)) {
+  if (encryptors.contains(mojom::kFilecoinTestnetKeyringId)) {
+    encryptors_[mojom::kFilecoinTestnetKeyringId] =
+        std::move(encryptors[mojom::kFilecoinTestnetKeyringId]);
+    if (!ResumeKeyringInternal(mojom::kFilecoinTestnetKeyringId)) {
       if (IsKeyringExist(mojom::kFilecoinTestnetKeyringId)) {
         VLOG(1) << __func__ << " Unable to unlock filecoin testnet keyring";
         encryptors_.erase(mojom::kFilecoinTestnetKeyringId);
-        std::move(callback).Run(false);
-        return;
+        return false;
       }
     }
   }
 
-  if (IsSolanaEnabled() && !ResumeKeyring(mojom::kSolanaKeyringId, password)) {
-    if (IsKeyringExist(mojom::kSolanaKeyringId)) {
+  if (encryptors.contains(mojom::kSolanaKeyringId)) {
+    encryptors_[mojom::kSolanaKeyringId] =
+        std::move(encryptors[mojom::kSolanaKeyringId]);
+    if (!ResumeKeyringInternal(mojom::kSolanaKeyringId) &&
+        IsKeyringExist(mojom::kSolanaKeyringId)) {
       VLOG(1) << __func__ << " Unable to unlock Solana keyring";
       encryptors_.erase(mojom::kSolanaKeyringId);
-      std::move(callback).Run(false);
-      return;
+      return false;
     }
   }
 
@@ -1741,7 +1845,7 @@ void KeyringService::Unlock(const std::string& password,
   }
   ResetAutoLockTimer();
 
-  std::move(callback).Run(true);
+  return true;
 }
 
 void KeyringService::OnAutoLockFired() {
@@ -1753,6 +1857,7 @@ void KeyringService::IsLocked(IsLockedCallback callback) {
 }
 
 void KeyringService::Reset(bool notify_observer) {
+  CancelPendingUnlocks();
   StopAutoLockTimer();
   encryptors_.clear();
   keyrings_.clear();
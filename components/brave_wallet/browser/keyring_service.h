@@ -8,8 +8,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -381,6 +384,18 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeKeyring(const std::string& keyring_id,
                            const std::string& password);
+  // Resumes a keyring whose encryptor is already created
+  HDKeyring* ResumeKeyringInternal(const std::string& keyring_id);
+  // Derives the keys of the first of |pending_unlocks_|.
+  void StartUnlock();
+  void OnUnlockEncryptorsDerived(
+      std::vector<std::pair<std::string, std::unique_ptr<PasswordEncryptor>>>
+          derived_encryptors);
+  // Drops the results of the unlock in progress and fails every pending one.
+  void CancelPendingUnlocks();
+  bool ResumeKeyringsWithEncryptors(
+      base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>
+          encryptors);
 
   void MaybeMigratePBKDF2Iterations(const std::string& password);
 
@@ -414,11 +429,16 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   raw_ptr<JsonRpcService> json_rpc_service_;
   raw_ptr<PrefService> prefs_ = nullptr;
   bool request_unlock_pending_ = false;
+  // <password, callback> of the Unlock calls not answered yet, the first one
+  // is in progress.
+  base::circular_deque<std::pair<std::string, UnlockCallback>>
+      pending_unlocks_;
 
   mojo::RemoteSet<mojom::KeyringServiceObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringService> receivers_;
 
   base::WeakPtrFactory<KeyringService> discovery_weak_factory_{this};
+  base::WeakPtrFactory<KeyringService> weak_ptr_factory_{this};
 
   KeyringService(const KeyringService&) = delete;
   KeyringService& operator=(const KeyringService&) = delete;
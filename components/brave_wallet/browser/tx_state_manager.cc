@@ -7,6 +7,8 @@
 
 #include <utility>
 
+#include "base/auto_reset.h"
+#include "base/bind.h"
 #include "base/json/values_util.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
@@ -92,17 +94,27 @@ TxStateManager::TxStateManager(PrefService* prefs,
                                JsonRpcService* json_rpc_service)
     : prefs_(prefs), json_rpc_service_(json_rpc_service), weak_factory_(this) {
   DCHECK(json_rpc_service_);
+  pref_change_registrar_.Init(prefs_);
+  pref_change_registrar_.Add(
+      kBraveWalletTransactions,
+      base::BindRepeating(&TxStateManager::OnTransactionsPrefChanged,
+                          base::Unretained(this)));
 }
 
 TxStateManager::~TxStateManager() = default;
 
 void TxStateManager::AddOrUpdateTx(const TxMeta& meta) {
+  base::AutoReset<bool> auto_reset(&is_updating_transactions_pref_, true);
   DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
   base::Value::Dict& dict = update.Get()->GetDict();
-  const std::string path = GetTxPrefPathPrefix() + "." + meta.id();
+  const std::string pref_path_prefix = GetTxPrefPathPrefix();
+  const std::string path = pref_path_prefix + "." + meta.id();
 
   bool is_add = dict.FindByDottedPath(path) == nullptr;
-  dict.SetByDottedPath(path, meta.ToValue());
+  base::Value::Dict value = meta.ToValue();
+  if (indexed_pref_path_prefix_ == pref_path_prefix)
+    IndexTx(meta.id(), meta.status(), meta.from(), GetTxNonce(value));
+  dict.SetByDottedPath(path, std::move(value));
   if (!is_add) {
     for (auto& observer : observers_)
       observer.OnTransactionStatusChanged(meta.ToTransactionInfo());
@@ -129,40 +141,162 @@ std::unique_ptr<TxMeta> TxStateManager::GetTx(const std::string& id) {
 }
 
 void TxStateManager::DeleteTx(const std::string& id) {
+  base::AutoReset<bool> auto_reset(&is_updating_transactions_pref_, true);
   DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
   base::Value* dict = update.Get();
-  dict->GetDict().RemoveByDottedPath(GetTxPrefPathPrefix() + "." + id);
+  const std::string pref_path_prefix = GetTxPrefPathPrefix();
+  dict->GetDict().RemoveByDottedPath(pref_path_prefix + "." + id);
+  if (indexed_pref_path_prefix_ == pref_path_prefix)
+    UnindexTx(id);
 }
 
 void TxStateManager::WipeTxs() {
+  base::AutoReset<bool> auto_reset(&is_updating_transactions_pref_, true);
   DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
   base::Value* dict = update.Get();
-  dict->GetDict().RemoveByDottedPath(GetTxPrefPathPrefix());
+  const std::string pref_path_prefix = GetTxPrefPathPrefix();
+  dict->GetDict().RemoveByDottedPath(pref_path_prefix);
+  if (indexed_pref_path_prefix_ == pref_path_prefix) {
+    tx_index_.clear();
+    tx_ids_by_status_.clear();
+    tx_ids_by_nonce_.clear();
+  }
 }
 
 std::vector<std::unique_ptr<TxMeta>> TxStateManager::GetTransactionsByStatus(
     absl::optional<mojom::TransactionStatus> status,
     absl::optional<std::string> from) {
   std::vector<std::unique_ptr<TxMeta>> result;
+  const std::string pref_path_prefix = GetTxPrefPathPrefix();
   const base::Value::Dict& dict =
       prefs_->GetValueDict(kBraveWalletTransactions);
   const base::Value::Dict* network_dict =
-      dict.FindDictByDottedPath(GetTxPrefPathPrefix());
+      dict.FindDictByDottedPath(pref_path_prefix);
   if (!network_dict)
     return result;
 
-  for (const auto it : *network_dict) {
-    std::unique_ptr<TxMeta> meta = ValueToTxMeta(it.second.GetDict());
-    if (!meta) {
+  EnsureTxIndex(pref_path_prefix, *network_dict);
+
+  // Only the selected txs are parsed, in id order as they are stored.
+  auto add_tx = [&](const std::string& id, const TxIndexEntry& entry) {
+    if (from.has_value() && entry.from != *from)
+      return;
+    const base::Value::Dict* value = network_dict->FindDict(id);
+    if (!value)
+      return;
+    std::unique_ptr<TxMeta> meta = ValueToTxMeta(*value);
+    if (!meta)
+      return;
+    result.push_back(std::move(meta));
+  };
+
+  if (!status.has_value()) {
+    for (const auto& [id, entry] : tx_index_)
+      add_tx(id, entry);
+    return result;
+  }
+
+  const auto it = tx_ids_by_status_.find(*status);
+  if (it == tx_ids_by_status_.end())
+    return result;
+  for (const auto& id : it->second)
+    add_tx(id, tx_index_.at(id));
+  return result;
+}
+
+bool TxStateManager::HasTxWithNonce(mojom::TransactionStatus status,
+                                    const std::string& from,
+                                    const std::string& nonce,
+                                    const std::string& id) {
+  const std::string pref_path_prefix = GetTxPrefPathPrefix();
+  const base::Value::Dict& dict =
+      prefs_->GetValueDict(kBraveWalletTransactions);
+  const base::Value::Dict* network_dict =
+      dict.FindDictByDottedPath(pref_path_prefix);
+  if (!network_dict)
+    return false;
+
+  EnsureTxIndex(pref_path_prefix, *network_dict);
+
+  const auto it = tx_ids_by_nonce_.find({from, nonce});
+  if (it == tx_ids_by_nonce_.end())
+    return false;
+  for (const auto& tx_id : it->second) {
+    if (tx_id != id && tx_index_.at(tx_id).status == status)
+      return true;
+  }
+  return false;
+}
+
+absl::optional<std::string> TxStateManager::GetTxNonce(
+    const base::Value::Dict& value) {
+  return absl::nullopt;
+}
+
+void TxStateManager::EnsureTxIndex(const std::string& pref_path_prefix,
+                                   const base::Value::Dict& network_dict) {
+  if (indexed_pref_path_prefix_ == pref_path_prefix)
+    return;
+
+  tx_index_.clear();
+  tx_ids_by_status_.clear();
+  tx_ids_by_nonce_.clear();
+  for (const auto [id, value] : network_dict) {
+    if (!value.is_dict())
       continue;
-    }
-    if (!status.has_value() || meta->status() == *status) {
-      if (from.has_value() && meta->from() != *from)
-        continue;
-      result.push_back(std::move(meta));
+    absl::optional<int> status = value.GetDict().FindInt("status");
+    const std::string* from = value.GetDict().FindString("from");
+    if (!status || !from)
+      continue;
+    IndexTx(id, static_cast<mojom::TransactionStatus>(*status), *from,
+            GetTxNonce(value.GetDict()));
+  }
+  indexed_pref_path_prefix_ = pref_path_prefix;
+}
+
+void TxStateManager::IndexTx(const std::string& id,
+                             mojom::TransactionStatus status,
+                             const std::string& from,
+                             absl::optional<std::string> nonce) {
+  UnindexTx(id);
+  if (nonce)
+    tx_ids_by_nonce_[{from, *nonce}].insert(id);
+  tx_index_[id] = {status, from, std::move(nonce)};
+  tx_ids_by_status_[status].insert(id);
+}
+
+void TxStateManager::UnindexTx(const std::string& id) {
+  const auto it = tx_index_.find(id);
+  if (it == tx_index_.end())
+    return;
+
+  const auto ids_it = tx_ids_by_status_.find(it->second.status);
+  if (ids_it != tx_ids_by_status_.end()) {
+    ids_it->second.erase(id);
+    if (ids_it->second.empty())
+      tx_ids_by_status_.erase(ids_it);
+  }
+  if (it->second.nonce) {
+    const auto nonce_ids_it =
+        tx_ids_by_nonce_.find({it->second.from, *it->second.nonce});
+    if (nonce_ids_it != tx_ids_by_nonce_.end()) {
+      nonce_ids_it->second.erase(id);
+      if (nonce_ids_it->second.empty())
+        tx_ids_by_nonce_.erase(nonce_ids_it);
     }
   }
-  return result;
+  tx_index_.erase(it);
+}
+
+void TxStateManager::OnTransactionsPrefChanged() {
+  // Changes made through this class keep the index up to date.
+  if (is_updating_transactions_pref_)
+    return;
+
+  indexed_pref_path_prefix_.reset();
+  tx_index_.clear();
+  tx_ids_by_status_.clear();
+  tx_ids_by_nonce_.clear();
 }
 
 void TxStateManager::RetireTxByStatus(mojom::TransactionStatus status,
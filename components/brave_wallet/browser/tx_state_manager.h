@@ -8,14 +8,18 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 class PrefService;
@@ -44,6 +48,13 @@ class TxStateManager {
       absl::optional<mojom::TransactionStatus> status,
       absl::optional<std::string> from);
 
+  // Returns whether a tx other than |id| with |status| was sent by |from| with
+  // |nonce|, see GetTxNonce. No stored tx meta is parsed.
+  bool HasTxWithNonce(mojom::TransactionStatus status,
+                      const std::string& from,
+                      const std::string& nonce,
+                      const std::string& id);
+
   class Observer : public base::CheckedObserver {
    public:
     virtual void OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) {
@@ -63,8 +74,29 @@ class TxStateManager {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(TxStateManagerUnitTest, TxOperations);
+  FRIEND_TEST_ALL_PREFIXES(TxStateManagerUnitTest, TxIndex);
+
+  // Status, sender and nonce of a stored tx, enough to select txs without
+  // parsing every stored tx meta.
+  struct TxIndexEntry {
+    mojom::TransactionStatus status;
+    std::string from;
+    absl::optional<std::string> nonce;
+  };
+
   void RetireTxByStatus(mojom::TransactionStatus status, size_t max_num);
 
+  // Rebuilds the tx index from |network_dict| unless it is already built for
+  // |pref_path_prefix|.
+  void EnsureTxIndex(const std::string& pref_path_prefix,
+                     const base::Value::Dict& network_dict);
+  void IndexTx(const std::string& id,
+               mojom::TransactionStatus status,
+               const std::string& from,
+               absl::optional<std::string> nonce);
+  void UnindexTx(const std::string& id);
+  void OnTransactionsPrefChanged();
+
   // Each derived class should implement its own ValueToTxMeta to create a
   // specific type of tx meta (ex: EthTxMeta) from a value. TxMeta
   // properties can be filled via the protected ValueToTxMeta function above.
@@ -77,8 +109,27 @@ class TxStateManager {
   // coin_type.
   virtual std::string GetTxPrefPathPrefix() = 0;
 
+  // Derived classes whose txs carry a nonce return it from the stored |value|
+  // of a tx, so that HasTxWithNonce can answer from the index.
+  virtual absl::optional<std::string> GetTxNonce(
+      const base::Value::Dict& value);
+
   base::ObserverList<Observer> observers_;
 
+  // Index of the txs stored under |indexed_pref_path_prefix_|. It is updated
+  // by writes made through this class and dropped on any other change to the
+  // transactions pref.
+  absl::optional<std::string> indexed_pref_path_prefix_;
+  base::flat_map<std::string, TxIndexEntry> tx_index_;
+  base::flat_map<mojom::TransactionStatus, base::flat_set<std::string>>
+      tx_ids_by_status_;
+  // <from, nonce>
+  base::flat_map<std::pair<std::string, std::string>,
+                 base::flat_set<std::string>>
+      tx_ids_by_nonce_;
+  bool is_updating_transactions_pref_ = false;
+  PrefChangeRegistrar pref_change_registrar_;
+
   base::WeakPtrFactory<TxStateManager> weak_factory_;
 };
 
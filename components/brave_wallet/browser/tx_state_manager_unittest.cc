@@ -277,6 +277,52 @@ TEST_F(TxStateManagerUnitTest, GetTransactionsByStatus) {
   }
 }
 
+TEST_F(TxStateManagerUnitTest, TxIndex) {
+  prefs_.ClearPref(kBraveWalletTransactions);
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                          absl::nullopt)
+                .size(),
+            1u);
+  EXPECT_TRUE(tx_state_manager_->indexed_pref_path_prefix_);
+
+  // Writes made through the tx state manager update the index in place
+  meta.set_status(mojom::TransactionStatus::Confirmed);
+  tx_state_manager_->AddOrUpdateTx(meta);
+  EXPECT_TRUE(tx_state_manager_->indexed_pref_path_prefix_);
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Submitted,
+                                          absl::nullopt)
+                .size(),
+            0u);
+  EXPECT_EQ(tx_state_manager_
+                ->GetTransactionsByStatus(mojom::TransactionStatus::Confirmed,
+                                          absl::nullopt)
+                .size(),
+            1u);
+
+  tx_state_manager_->DeleteTx("001");
+  EXPECT_TRUE(tx_state_manager_->indexed_pref_path_prefix_);
+  EXPECT_EQ(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, absl::nullopt)
+          .size(),
+      0u);
+
+  // Any other change to the pref drops the index
+  tx_state_manager_->AddOrUpdateTx(meta);
+  prefs_.ClearPref(kBraveWalletTransactions);
+  EXPECT_FALSE(tx_state_manager_->indexed_pref_path_prefix_);
+  EXPECT_EQ(
+      tx_state_manager_->GetTransactionsByStatus(absl::nullopt, absl::nullopt)
+          .size(),
+      0u);
+}
+
 TEST_F(TxStateManagerUnitTest, SwitchNetwork) {
   prefs_.ClearPref(kBraveWalletTransactions);
 
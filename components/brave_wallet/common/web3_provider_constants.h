@@ -34,6 +34,9 @@ constexpr char kEthRequestAccounts[] = "eth_requestAccounts";
 constexpr char kEthSendTransaction[] = "eth_sendTransaction";
 constexpr char kEthGetBlockByNumber[] = "eth_getBlockByNumber";
 constexpr char kEthBlockNumber[] = "eth_blockNumber";
+constexpr char kEthChainId[] = "eth_chainId";
+constexpr char kEthGasPrice[] = "eth_gasPrice";
+constexpr char kEthFeeHistory[] = "eth_feeHistory";
 constexpr char kEthSign[] = "eth_sign";
 constexpr char kPersonalSign[] = "personal_sign";
 constexpr char kPersonalEcRecover[] = "personal_ecRecover";
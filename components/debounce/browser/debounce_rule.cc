@@ -5,7 +5,10 @@
 
 #include "brave/components/debounce/browser/debounce_rule.h"
 
+#include <iterator>
+#include <map>
 #include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -120,9 +123,7 @@ const std::string DebounceRule::GetETLDForDebounce(const std::string& host) {
 }
 
 // static
-base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                         base::flat_set<std::string>>,
-               std::string>
+base::expected<std::vector<std::unique_ptr<DebounceRule>>, std::string>
 DebounceRule::ParseRules(const std::string& contents) {
   if (contents.empty()) {
     return base::unexpected("Could not obtain debounce configuration");
@@ -131,25 +132,52 @@ DebounceRule::ParseRules(const std::string& contents) {
   if (!root) {
     return base::unexpected("Failed to parse debounce configuration");
   }
-  std::vector<std::string> hosts;
   std::vector<std::unique_ptr<DebounceRule>> rules;
   base::JSONValueConverter<DebounceRule> converter;
   for (base::Value& it : root->GetList()) {
     std::unique_ptr<DebounceRule> rule = std::make_unique<DebounceRule>();
     if (!converter.Convert(it, rule.get()))
       continue;
-    for (const URLPattern& pattern : rule->include_pattern_set()) {
-      if (!pattern.host().empty()) {
-        const std::string etldp1 =
-            DebounceRule::GetETLDForDebounce(pattern.host());
-        if (!etldp1.empty())
-          hosts.push_back(std::move(etldp1));
+    if (rule->action_ == kDebounceRegexPath)
+      rule->CompileParamRegex();
+    rules.push_back(std::move(rule));
+  }
+  return rules;
+}
+
+// static
+DebounceRulesByETLD DebounceRule::IndexRulesByETLD(
+    const std::vector<std::unique_ptr<DebounceRule>>& rules) {
+  std::map<std::string, std::vector<const DebounceRule*>> index;
+  std::vector<std::set<std::string>> rule_etlds(rules.size());
+  std::vector<bool> rule_matches_any_etld(rules.size(), false);
+  for (size_t i = 0; i < rules.size(); ++i) {
+    for (const URLPattern& pattern : rules[i]->include_pattern_set()) {
+      const std::string etldp1 =
+          pattern.host().empty()
+              ? std::string()
+              : DebounceRule::GetETLDForDebounce(pattern.host());
+      if (etldp1.empty()) {
+        rule_matches_any_etld[i] = true;
+        continue;
       }
+      rule_etlds[i].insert(etldp1);
+      index[etldp1];
     }
-    rules.push_back(std::move(rule));
   }
-  return std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                   base::flat_set<std::string>>(std::move(rules), hosts);
+
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (rule_matches_any_etld[i]) {
+      for (auto& entry : index)
+        entry.second.push_back(rules[i].get());
+      continue;
+    }
+    for (const std::string& etldp1 : rule_etlds[i])
+      index[etldp1].push_back(rules[i].get());
+  }
+
+  return DebounceRulesByETLD(std::make_move_iterator(index.begin()),
+                             std::make_move_iterator(index.end()));
 }
 
 bool DebounceRule::CheckPrefForRule(const PrefService* prefs) const {
@@ -169,36 +197,41 @@ bool DebounceRule::CheckPrefForRule(const PrefService* prefs) const {
   return true;
 }
 
-bool DebounceRule::ValidateAndParsePatternRegex(
-    const std::string& pattern,
-    const std::string& path,
-    std::string* parsed_value) const {
-  if (pattern.length() > kMaxLengthRegexPattern) {
+void DebounceRule::CompileParamRegex() {
+  param_regex_.reset();
+  if (param_.length() > kMaxLengthRegexPattern) {
     VLOG(1) << "Debounce regex pattern exceeds max length: "
             << kMaxLengthRegexPattern;
-    return false;
+    return;
   }
   re2::RE2::Options options;
   options.set_max_mem(kMaxMemoryPerRegexPattern);
-  const re2::RE2 pattern_regex(pattern, options);
+  auto pattern_regex = std::make_unique<re2::RE2>(param_, options);
 
-  if (!pattern_regex.ok()) {
-    VLOG(1) << "Debounce rule has param: " << pattern
+  if (!pattern_regex->ok()) {
+    VLOG(1) << "Debounce rule has param: " << param_
             << " which is an invalid regex pattern";
-    return false;
+    return;
   }
-  if (pattern_regex.NumberOfCapturingGroups() < 1) {
-    VLOG(1) << "Debounce rule has param: " << pattern
+  if (pattern_regex->NumberOfCapturingGroups() < 1) {
+    VLOG(1) << "Debounce rule has param: " << param_
             << " which captures < 1 groups";
-    return false;
+    return;
   }
+  param_regex_ = std::move(pattern_regex);
+}
+
+bool DebounceRule::ParsePatternRegex(const std::string& path,
+                                     std::string* parsed_value) const {
+  if (!param_regex_)
+    return false;
 
   // Get matching capture groups by applying regex to the path
   size_t number_of_capturing_groups =
-      pattern_regex.NumberOfCapturingGroups() + 1;
+      param_regex_->NumberOfCapturingGroups() + 1;
   std::vector<re2::StringPiece> match_results(number_of_capturing_groups);
 
-  if (!pattern_regex.Match(path, 0, path.size(), RE2::UNANCHORED,
+  if (!param_regex_->Match(path, 0, path.size(), RE2::UNANCHORED,
                            match_results.data(), match_results.size())) {
     VLOG(1) << "Debounce rule with param: " << param_
             << " was unable to capture string";
@@ -250,7 +283,7 @@ bool DebounceRule::Apply(const GURL& original_url,
     // Important: Apply param regex to ONLY the path of original URL.
     auto path = original_url.path();
 
-    if (!ValidateAndParsePatternRegex(param_, path, &unescaped_value)) {
+    if (!ParsePatternRegex(path, &unescaped_value)) {
       VLOG(1) << "Debounce regex parsing failed";
       return false;
     }
@@ -11,7 +11,7 @@
 #include <utility>
 #include <vector>
 
-#include "base/containers/flat_set.h"
+#include "base/containers/flat_map.h"
 #include "base/json/json_value_converter.h"
 #include "base/strings/escape.h"
 #include "base/types/expected.h"
@@ -21,6 +21,10 @@
 
 class GURL;
 
+namespace re2 {
+class RE2;
+}  // namespace re2
+
 namespace debounce {
 
 enum DebounceAction {
@@ -36,6 +40,13 @@ enum DebouncePrependScheme {
   kDebounceSchemePrependHttps
 };
 
+class DebounceRule;
+
+// Maps an eTLD+1 to the rules which may apply to URLs on it, in the order the
+// rules appear in the configuration.
+using DebounceRulesByETLD =
+    base::flat_map<std::string, std::vector<const DebounceRule*>>;
+
 class DebounceRule {
  public:
   DebounceRule();
@@ -49,10 +60,14 @@ class DebounceRule {
                                   DebounceAction* field);
   static bool ParsePrependScheme(base::StringPiece value,
                                  DebouncePrependScheme* field);
-  static base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                                  base::flat_set<std::string>>,
+  static base::expected<std::vector<std::unique_ptr<DebounceRule>>,
                         std::string>
   ParseRules(const std::string& contents);
+  // Builds the eTLD+1 index for |rules|, which must outlive it. Rules with an
+  // include pattern that isn't tied to a single eTLD+1 are listed under every
+  // indexed eTLD+1.
+  static DebounceRulesByETLD IndexRulesByETLD(
+      const std::vector<std::unique_ptr<DebounceRule>>& rules);
   static const std::string GetETLDForDebounce(const std::string& host);
   static bool GetURLPatternSetFromValue(const base::Value* value,
                                         extensions::URLPatternSet* result);
@@ -66,15 +81,18 @@ class DebounceRule {
 
  private:
   bool CheckPrefForRule(const PrefService* prefs) const;
-  bool ValidateAndParsePatternRegex(const std::string& pattern,
-                                    const std::string& path,
-                                    std::string* parsed_value) const;
+  void CompileParamRegex();
+  bool ParsePatternRegex(const std::string& path,
+                         std::string* parsed_value) const;
   extensions::URLPatternSet include_pattern_set_;
   extensions::URLPatternSet exclude_pattern_set_;
   DebounceAction action_;
   DebouncePrependScheme prepend_scheme_;
   std::string param_;
   std::string pref_;
+  // Compiled from |param_| for kDebounceRegexPath rules, null if |param_| is
+  // not a valid pattern.
+  std::unique_ptr<re2::RE2> param_regex_;
 };
 
 }  // namespace debounce
@@ -17,7 +17,7 @@ namespace debounce {
 std::vector<std::unique_ptr<DebounceRule>> StringToRules(std::string contents) {
   auto parsed = DebounceRule::ParseRules(contents);
   EXPECT_TRUE(parsed.has_value());
-  return std::move(parsed.value().first);
+  return std::move(parsed.value());
 }
 
 void CheckApplyResult(DebounceRule* rule,
@@ -445,4 +445,72 @@ TEST(DebounceRuleUnitTest, CatchMultiplePathsForSameInclude) {
   }
 }
 
+TEST(DebounceRuleUnitTest, IndexRulesByETLD) {
+  const std::string contents = R"json(
+
+      [{
+          "include": [
+              "*://a.test.com/*",
+              "*://*.other.com/*"
+          ],
+          "exclude": [
+          ],
+          "action": "redirect",
+          "param": "url"
+      }, {
+          "include": [
+              "*://*/*"
+          ],
+          "exclude": [
+          ],
+          "action": "redirect",
+          "param": "url"
+      }, {
+          "include": [
+              "*://test.com/*"
+          ],
+          "exclude": [
+          ],
+          "action": "redirect",
+          "param": "url"
+      }]
+
+      )json";
+  std::vector<std::unique_ptr<DebounceRule>> rules = StringToRules(contents);
+  ASSERT_EQ(3u, rules.size());
+
+  DebounceRulesByETLD index = DebounceRule::IndexRulesByETLD(rules);
+  ASSERT_EQ(2u, index.size());
+  // Rules without a single eTLD+1 apply to every indexed one, and the order
+  // from the configuration is kept.
+  EXPECT_EQ(std::vector<const DebounceRule*>(
+                {rules[0].get(), rules[1].get(), rules[2].get()}),
+            index["test.com"]);
+  EXPECT_EQ(
+      std::vector<const DebounceRule*>({rules[0].get(), rules[1].get()}),
+      index["other.com"]);
+}
+
+TEST(DebounceRuleUnitTest, RegexReusedAcrossApplies) {
+  const std::string contents = R"json(
+
+      [{
+          "include": [
+              "*://test.com/*"
+          ],
+          "exclude": [],
+          "action": "regex-path",
+          "param": "^/(.*)$"
+      }]
+
+    )json";
+  std::vector<std::unique_ptr<DebounceRule>> rules = StringToRules(contents);
+  ASSERT_EQ(1u, rules.size());
+
+  CheckApplyResult(rules[0].get(), GURL("https://test.com/https://brave.com/a"),
+                   "https://brave.com/a", false);
+  CheckApplyResult(rules[0].get(), GURL("https://test.com/https://brave.com/b"),
+                   "https://brave.com/b", false);
+}
+
 }  // namespace debounce
@@ -74,6 +74,12 @@ void BatAdsImpl::OnPrefDidChange(const std::string& path) {
   ads_->OnPrefDidChange(path);
 }
 
+void BatAdsImpl::IsFullHtmlContentNeeded(
+    const std::vector<GURL>& redirect_chain,
+    IsFullHtmlContentNeededCallback callback) {
+  std::move(callback).Run(ads_->IsFullHtmlContentNeeded(redirect_chain));
+}
+
 void BatAdsImpl::OnTabHtmlContentDidChange(
     const int32_t tab_id,
     const std::vector<GURL>& redirect_chain,
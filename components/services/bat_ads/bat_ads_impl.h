@@ -52,6 +52,9 @@ class BatAdsImpl :
 
   void OnDidUpdateResourceComponent(const std::string& id) override;
 
+  void IsFullHtmlContentNeeded(
+      const std::vector<GURL>& redirect_chain,
+      IsFullHtmlContentNeededCallback callback) override;
   void OnTabHtmlContentDidChange(const int32_t tab_id,
                                  const std::vector<GURL>& redirect_chain,
                                  const std::string& html) override;
@@ -5,11 +5,15 @@
 
 #include "brave/components/url_sanitizer/browser/url_sanitizer_service.h"
 
+#include <iterator>
+#include <map>
 #include <memory>
 #include <vector>
 
+#include "base/containers/contains.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/task/task_runner_util.h"
@@ -48,8 +52,26 @@ absl::optional<base::flat_set<std::string>> CreateParamsList(
   return result;
 }
 
-base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
-    const std::string& json) {
+void IndexMatchItem(
+    const URLSanitizerService::MatchItem* item,
+    std::map<std::string, std::vector<const URLSanitizerService::MatchItem*>>*
+        by_host,
+    std::vector<const URLSanitizerService::MatchItem*>* any_host) {
+  bool indexed_for_any_host = false;
+  for (const URLPattern& pattern : item->include) {
+    if (pattern.match_all_urls() || pattern.host().empty()) {
+      if (!indexed_for_any_host)
+        any_host->push_back(item);
+      indexed_for_any_host = true;
+      continue;
+    }
+    auto& items = (*by_host)[pattern.host()];
+    if (items.empty() || items.back() != item)
+      items.push_back(item);
+  }
+}
+
+URLSanitizerService::Matchers ParseFromJson(const std::string& json) {
   auto parsed_json = base::JSONReader::ReadAndReturnValueWithError(json);
   if (!parsed_json.has_value()) {
     VLOG(1) << "Error parsing feature JSON: " << parsed_json.error().message;
@@ -59,7 +81,9 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
   if (!list) {
     return {};
   }
-  base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers;
+  URLSanitizerService::Matchers matchers;
+  std::map<std::string, std::vector<const URLSanitizerService::MatchItem*>>
+      by_host;
   for (const auto& it : *list) {
     const base::Value::Dict* items = it.GetIfDict();
     if (!items)
@@ -83,18 +107,70 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
         std::move(include_matcher), std::move(exclude_matcher),
         std::move(*params));
 
-    matchers.insert(std::move(item));
+    IndexMatchItem(item.get(), &by_host, &matchers.any_host);
+    matchers.items.push_back(std::move(item));
   }
+  matchers.by_host = base::flat_map<
+      std::string, std::vector<const URLSanitizerService::MatchItem*>>(
+      std::make_move_iterator(by_host.begin()),
+      std::make_move_iterator(by_host.end()));
 
   return matchers;
 }
 
+// Removes the parameters listed in any of |trackers| from |query| in a single
+// pass.
+std::string StripQueryParameters(
+    base::StringPiece query,
+    const std::vector<const base::flat_set<std::string>*>& trackers) {
+  // We are using custom query string parsing code here. See
+  // https://github.com/brave/brave-core/pull/13726#discussion_r897712350
+  // for more information on why this approach was selected.
+  //
+  // Split query string by ampersands, remove tracking parameters,
+  // then join the remaining query parameters, untouched, back into
+  // a single query string.
+  const std::vector<base::StringPiece> input_kv_strings =
+      base::SplitStringPiece(query, "&", base::KEEP_WHITESPACE,
+                             base::SPLIT_WANT_ALL);
+  std::string output;
+  output.reserve(query.size());
+  bool first = true;
+  int disallowed_count = 0;
+  for (const base::StringPiece kv_string : input_kv_strings) {
+    const std::vector<base::StringPiece> pieces = base::SplitStringPiece(
+        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (pieces.size() >= 2 &&
+        base::ranges::any_of(trackers, [&pieces](const auto* params) {
+          return params->contains(pieces[0]);
+        })) {
+      ++disallowed_count;
+      continue;
+    }
+    if (!first)
+      output.push_back('&');
+    output.append(kv_string.data(), kv_string.size());
+    first = false;
+  }
+  if (disallowed_count > 0) {
+    return output;
+  } else {
+    return std::string(query);
+  }
+}
+
 }  // namespace
 
 URLSanitizerService::URLSanitizerService() = default;
 
 URLSanitizerService::~URLSanitizerService() = default;
 
+URLSanitizerService::Matchers::Matchers() = default;
+URLSanitizerService::Matchers::Matchers(Matchers&&) = default;
+URLSanitizerService::Matchers& URLSanitizerService::Matchers::operator=(
+    Matchers&&) = default;
+URLSanitizerService::Matchers::~Matchers() = default;
+
 URLSanitizerService::MatchItem::MatchItem() = default;
 URLSanitizerService::MatchItem::~MatchItem() = default;
 
@@ -110,30 +186,61 @@ void URLSanitizerService::Initialize(const std::string& json) {
                      weak_factory_.GetWeakPtr()));
 }
 
-void URLSanitizerService::UpdateMatchers(
-    base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> mappings) {
-  matchers_ = std::move(mappings);
+void URLSanitizerService::UpdateMatchers(Matchers matchers) {
+  matchers_ = std::move(matchers);
   if (initialization_callback_for_testing_)
     std::move(initialization_callback_for_testing_).Run();
 }
 
 GURL URLSanitizerService::SanitizeURL(const GURL& initial_url) {
-  if (matchers_.empty())
+  if (matchers_.items.empty())
     return initial_url;
-  GURL url = initial_url;
-  for (const auto& it : matchers_) {
-    if (!it->include.MatchesURL(url) || it->exclude.MatchesURL(url))
-      continue;
-    auto sanitized_query = StripQueryParameter(url.query(), it->params);
-    GURL::Replacements replacements;
-    if (!sanitized_query.empty()) {
-      replacements.SetQueryStr(sanitized_query);
-    } else {
-      replacements.ClearQuery();
+
+  // Collect the items indexed under the host or any of its parent domains.
+  std::vector<const MatchItem*> candidates = matchers_.any_host;
+  base::StringPiece host = initial_url.host_piece();
+  while (!host.empty()) {
+    auto it = matchers_.by_host.find(host);
+    if (it != matchers_.by_host.end()) {
+      for (const MatchItem* item : it->second) {
+        if (!base::Contains(candidates, item))
+          candidates.push_back(item);
+      }
     }
-    url = url.ReplaceComponents(replacements);
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
   }
-  return url;
+
+  std::vector<const base::flat_set<std::string>*> trackers;
+  for (const MatchItem* item : candidates) {
+    if (!item->include.MatchesURL(initial_url) ||
+        item->exclude.MatchesURL(initial_url))
+      continue;
+    trackers.push_back(&item->params);
+  }
+  if (trackers.empty())
+    return initial_url;
+
+  auto sanitized_query =
+      StripQueryParameters(initial_url.query_piece(), trackers);
+  GURL::Replacements replacements;
+  if (!sanitized_query.empty()) {
+    replacements.SetQueryStr(sanitized_query);
+  } else {
+    replacements.ClearQuery();
+  }
+  return initial_url.ReplaceComponents(replacements);
+}
+
+std::vector<GURL> URLSanitizerService::SanitizeURLs(
+    const std::vector<GURL>& urls) {
+  std::vector<GURL> result;
+  result.reserve(urls.size());
+  for (const GURL& url : urls)
+    result.push_back(SanitizeURL(url));
+  return result;
 }
 
 void URLSanitizerService::OnRulesReady(const std::string& json_content) {
@@ -147,32 +254,7 @@ void URLSanitizerService::OnRulesReady(const std::string& json_content) {
 std::string URLSanitizerService::StripQueryParameter(
     const std::string& query,
     const base::flat_set<std::string>& trackers) {
-  // We are using custom query string parsing code here. See
-  // https://github.com/brave/brave-core/pull/13726#discussion_r897712350
-  // for more information on why this approach was selected.
-  //
-  // Split query string by ampersands, remove tracking parameters,
-  // then join the remaining query parameters, untouched, back into
-  // a single query string.
-  const std::vector<std::string> input_kv_strings =
-      SplitString(query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  std::vector<std::string> output_kv_strings;
-  int disallowed_count = 0;
-  for (const std::string& kv_string : input_kv_strings) {
-    const std::vector<std::string> pieces = SplitString(
-        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-    const std::string& key = pieces.empty() ? std::string() : pieces[0];
-    if (pieces.size() >= 2 && trackers.count(key) == 1) {
-      ++disallowed_count;
-    } else {
-      output_kv_strings.push_back(kv_string);
-    }
-  }
-  if (disallowed_count > 0) {
-    return base::JoinString(output_kv_strings, "&");
-  } else {
-    return query;
-  }
+  return StripQueryParameters(query, {&trackers});
 }
 
 }  // namespace brave
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
@@ -41,7 +42,24 @@ class URLSanitizerService : public KeyedService,
     base::flat_set<std::string> params;
   };
 
+  // Match items indexed by the hosts their include patterns apply to.
+  struct Matchers {
+    Matchers();
+    Matchers(Matchers&&);
+    Matchers& operator=(Matchers&&);
+    ~Matchers();
+
+    std::vector<std::unique_ptr<MatchItem>> items;
+    // Items with an include pattern restricted to a host (and possibly its
+    // subdomains), keyed by that host.
+    base::flat_map<std::string, std::vector<const MatchItem*>> by_host;
+    // Items with an include pattern which matches any host.
+    std::vector<const MatchItem*> any_host;
+  };
+
   GURL SanitizeURL(const GURL& url);
+  // Sanitizes each of |urls|, e.g. when sharing or importing many at once.
+  std::vector<GURL> SanitizeURLs(const std::vector<GURL>& urls);
 
   void SetInitializationCallbackForTesting(base::OnceClosure callback) {
     initialization_callback_for_testing_ = std::move(callback);
@@ -52,14 +70,13 @@ class URLSanitizerService : public KeyedService,
  protected:
   friend class URLSanitizerServiceUnitTest;
 
-  void UpdateMatchers(
-      base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>>);
+  void UpdateMatchers(Matchers matchers);
 
   std::string StripQueryParameter(const std::string& query,
                                   const base::flat_set<std::string>& trackers);
 
  private:
-  base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers_;
+  Matchers matchers_;
   base::OnceClosure initialization_callback_for_testing_;
   base::WeakPtrFactory<URLSanitizerService> weak_factory_{this};
 };
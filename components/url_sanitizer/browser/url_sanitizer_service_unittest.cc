@@ -144,4 +144,41 @@ TEST_F(URLSanitizerServiceUnitTest, ClearURLS) {
       GURL("http://subpage.twitter.com/post/?utm_content=removethis&e=&=end"));
 }
 
+TEST_F(URLSanitizerServiceUnitTest, MergesMatchingItems) {
+  WaitInitialization(kTestPatterns);
+
+  // Parameters from every matching item are stripped in one go.
+  EXPECT_EQ(SanitizeURL(GURL("https://www.twitter.com/post/"
+                             "?t=1&utm_content=2&keep=3&utm_affiliate=4")),
+            GURL("https://www.twitter.com/post/?keep=3"));
+  EXPECT_EQ(SanitizeURL(GURL("https://twitter.com/?t=1&utm_content=2")),
+            GURL("https://twitter.com/"));
+  // Host indexed items don't leak onto other hosts.
+  EXPECT_EQ(SanitizeURL(GURL("https://nottwitter.com/?t=1&utm_content=2")),
+            GURL("https://nottwitter.com/?t=1"));
+  EXPECT_EQ(SanitizeURL(GURL("https://bravesoftware.com/clean-urls/"
+                             "?brave_testing1=foo")),
+            GURL("https://bravesoftware.com/clean-urls/?brave_testing1=foo"));
+}
+
+TEST_F(URLSanitizerServiceUnitTest, SanitizeURLs) {
+  WaitInitialization(kTestPatterns);
+
+  std::vector<GURL> urls = {
+      GURL("https://twitter.com/post/?t=1&e=2"),
+      GURL("https://brave.com/?utm_content=1"),
+      GURL("https://dev-pages.bravesoftware.com/clean-urls/"
+           "?brave_testing1=foo&brave_testing3=keep"),
+      GURL("chrome://settings/?utm_content=1"),
+  };
+  std::vector<GURL> expected = {
+      GURL("https://twitter.com/post/?e=2"),
+      GURL("https://brave.com/"),
+      GURL("https://dev-pages.bravesoftware.com/clean-urls/"
+           "?brave_testing3=keep"),
+      GURL("chrome://settings/?utm_content=1"),
+  };
+  EXPECT_EQ(SanitizeURLs(urls), expected);
+}
+
 }  // namespace brave
@@ -7,6 +7,7 @@
 
 #include "base/feature_list.h"
 #include "brave/components/brave_ads/common/features.h"
+#include "brave/components/brave_ads/renderer/page_features_render_frame_observer.h"
 #include "brave/components/brave_search/common/brave_search_utils.h"
 #include "brave/components/brave_search/renderer/brave_search_render_frame_observer.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -100,6 +101,11 @@ void BraveContentRendererClient::RenderFrameCreated(
         base::BindRepeating(&BraveRenderThreadObserver::GetDynamicParams));
   }
 
+  if (render_frame->IsMainFrame()) {
+    new brave_ads::PageFeaturesRenderFrameObserver(
+        render_frame, ISOLATED_WORLD_ID_BRAVE_INTERNAL);
+  }
+
   if (brave_search::IsDefaultAPIEnabled()) {
     new brave_search::BraveSearchRenderFrameObserver(
         render_frame, content::ISOLATED_WORLD_ID_GLOBAL);
@@ -5,6 +5,7 @@
 
 #include "brave/third_party/blink/renderer/core/farbling/brave_session_cache.h"
 
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/sequence_checker.h"
@@ -44,30 +45,77 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
+// returns pseudo-random float between 0 and 0.1
+inline float PseudoRandomSample(uint64_t v) {
+  return (v / maxUInt64AsDouble) / 10;
 }
 
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
+}  // namespace
+
+namespace brave {
+
+AudioFarbler::AudioFarbler() = default;
+
+// static
+AudioFarbler AudioFarbler::ConstantMultiplier(double fudge_factor) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kConstantMultiplier;
+  farbler.fudge_factor_ = fudge_factor;
+  return farbler;
 }
 
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
+// static
+AudioFarbler AudioFarbler::PseudoRandomSequence(uint64_t seed) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kPseudoRandomSequence;
+  farbler.seed_ = seed;
+  return farbler;
 }
 
-}  // namespace
+void AudioFarbler::FarbleSamples(float* data, size_t count) const {
+  switch (mode_) {
+    case Mode::kIdentity:
+      break;
+    case Mode::kConstantMultiplier: {
+      // Kept as a plain loop so that it gets vectorized. The product is
+      // computed in double precision, like FarbleSample() does.
+      const double fudge_factor = fudge_factor_;
+      for (size_t i = 0; i < count; ++i)
+        data[i] = data[i] * fudge_factor;
+      break;
+    }
+    case Mode::kPseudoRandomSequence: {
+      // the sequence starts from the seed, which is based on the domain key
+      uint64_t v = seed_;
+      for (size_t i = 0; i < count; ++i) {
+        v = lfsr_next(v);
+        data[i] = PseudoRandomSample(v);
+      }
+      break;
+    }
+  }
+}
 
-namespace brave {
+float AudioFarbler::FarbleSample(float value,
+                                 size_t index,
+                                 uint64_t* state) const {
+  switch (mode_) {
+    case Mode::kIdentity:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence:
+      if (index == 0) {
+        // start of loop, reset to initial seed which is based on the domain
+        // key
+        *state = seed_;
+      }
+      // get next value in PRNG sequence
+      *state = lfsr_next(*state);
+      return PseudoRandomSample(*state);
+  }
+  return value;
+}
 
 const char kBraveSessionToken[] = "brave_session_token";
 const char BraveSessionCache::kSupplementName[] = "BraveSessionCache";
@@ -231,7 +279,7 @@ void BraveSessionCache::Init() {
   RegisterAllowFontFamilyCallback(base::BindRepeating(&brave::AllowFontFamily));
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarbler BraveSessionCache::GetAudioFarbler(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -243,15 +291,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarbler::ConstantMultiplier(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarbler::PseudoRandomSequence(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarbler();
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
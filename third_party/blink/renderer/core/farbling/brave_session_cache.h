@@ -9,7 +9,6 @@
 #include <map>
 #include <string>
 
-#include "base/callback.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "third_party/abseil-cpp/absl/random/random.h"
 #include "third_party/blink/renderer/core/core_export.h"
@@ -41,7 +40,31 @@ enum FarbleKey : uint64_t {
 };
 
 typedef absl::randen_engine<uint64_t> FarblingPRNG;
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+
+// Farbles Web Audio samples. It holds no sequence state, so the same farbler
+// can be used from several threads at once.
+class CORE_EXPORT AudioFarbler {
+ public:
+  AudioFarbler();
+  static AudioFarbler ConstantMultiplier(double fudge_factor);
+  static AudioFarbler PseudoRandomSequence(uint64_t seed);
+
+  explicit operator bool() const { return mode_ != Mode::kIdentity; }
+
+  // Farbles the |count| samples at |data| in place, as one sequence.
+  void FarbleSamples(float* data, size_t count) const;
+  // Farbles a single sample, for loops which transform samples one at a time.
+  // |index| must count up from 0 for each sequence, and |state| must be kept
+  // by the caller for the whole sequence.
+  float FarbleSample(float value, size_t index, uint64_t* state) const;
+
+ private:
+  enum class Mode { kIdentity, kConstantMultiplier, kPseudoRandomSequence };
+
+  Mode mode_ = Mode::kIdentity;
+  double fudge_factor_ = 1.0;
+  uint64_t seed_ = 0;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -74,8 +97,7 @@ class CORE_EXPORT BraveSessionCache final
   static BraveSessionCache& From(ExecutionContext&);
   static void Init();
 
-  AudioFarblingCallback GetAudioFarblingCallback(
-      blink::WebContentSettingsClient* settings);
+  AudioFarbler GetAudioFarbler(blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
                      size_t size);